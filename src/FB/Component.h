@@ -25,6 +25,7 @@
 #include "cpm_Define.h"
 #include <string>
 #include <string.h>
+#include <vector>
 #include "FB_Define.h"
 
 
@@ -138,6 +139,7 @@ private:
   int usw;               /// 汎用変数
   int heatmode;          /// 熱輸送のときON
   int matodr;            /// MediumListのエントリ番号、Medium名と対応
+  std::vector<int> cell_list; ///< 処理対象セルのリスト (i, j, k, 面フラグ)の4要素の組
   
   REAL_TYPE var1;        /// パラメータ保持 (Velocity, Pressure, Massflow, Epsiolon of Radiation)
   REAL_TYPE var2;        /// パラメータ保持 (Heat Value, Heat flux, Heat Transfer, Pressure loss, Projection of Radiation)
@@ -220,6 +222,41 @@ public:
   }
   
   
+  //@brief セルリストの要素数を返す
+  int getCellListSize() const
+  {
+    return (int)(cell_list.size() / 4);
+  }
+  
+  
+  //@brief セルリストの先頭アドレスを返す
+  int* getCellList()
+  {
+    return cell_list.empty() ? NULL : &cell_list[0];
+  }
+  
+  
+  /**
+   * @brief セルリストに追加
+   * @param [in] i,j,k インデクス
+   * @param [in] fc    面フラグ
+   */
+  void addCellList(const int i, const int j, const int k, const int fc)
+  {
+    cell_list.push_back(i);
+    cell_list.push_back(j);
+    cell_list.push_back(k);
+    cell_list.push_back(fc);
+  }
+  
+  
+  //@brief セルリストを空にする
+  void clearCellList()
+  {
+    std::vector<int>().swap(cell_list);
+  }
+  
+  
   //@brief コンポーネントのBbox情報edのアドレスを返す
   int* getBbox_ed()
   {
@@ -34,6 +34,7 @@
 #include "IterationControl.h"
 #include "TextParser.h"
 #include "IntervalManager.h"
+#include "LogChannel.h"
 
 using namespace std;
 using namespace Vec3class;
@@ -118,6 +119,38 @@ public:
   }
   
   
+  /** 最小格子幅を返す */
+  double get_MinDX() const
+  {
+    return min_dx;
+  }
+  
+  
+  /**
+   * @brief 局所時間刻みで用いるCFL数
+   * @note CFL指定のスキームはその値，Δt直接指定の場合は参照速度1.0に対するCFL数
+   */
+  double cflLocal() const
+  {
+    if ( scheme == dt_direct ) return deltaT / min_dx;
+    return CFL;
+  }
+  
+  
+  /**
+   * @brief 局所時間刻みの上限
+   * @param [in] ratio Δtに対する倍率
+   * @note 陽的な粘性項の安定条件（拡散数）で制限，ただしΔtを下回らない
+   */
+  double dtLocalMax(const double ratio) const
+  {
+    double a = ratio * deltaT;
+    double b = dtDFN(Reynolds);
+    if ( a > b ) a = b;
+    return (a < deltaT) ? deltaT : a;
+  }
+  
+  
   /** 時間積分幅とKindOfSolver種別の整合性をチェック */
   bool chkDtSelect();
   
@@ -277,9 +310,12 @@ public:
     int Example;
     int Log_Base;
     int Log_Wall;
+    int Log_Format;
     int PDE;
     int Precision;
     int Profiling;
+    int Trace;
+    int HwCounter;
     int PrsNeuamnnType;
     int ShapeAprx;
     int Steady;
@@ -291,6 +327,7 @@ public:
     int ReynoldsStress;
     int ChannelOutputIter;
     int ChannelOutputMean;
+    int StatStorage;
   } Mode_set;
   
   /** 隠しパラメータ */
@@ -375,6 +412,23 @@ public:
   } Stability_Control;
   
   
+  // 定常解の加速と自動終了のパラメータ
+  typedef struct
+  {
+    int lts;           ///< 局所時間刻み
+    int smooth;        ///< 残差平滑化
+    int sweep;         ///< 平滑化の反復回数
+    int terminate;     ///< 収束判定による自動終了
+    int window;        ///< 判定に用いるサンプル数
+    REAL_TYPE ratio;   ///< 局所時間刻みの上限（Δtに対する倍率）
+    REAL_TYPE eps;     ///< 平滑化係数
+    REAL_TYPE tol_v;   ///< 速度変動量の許容変化率
+    REAL_TYPE tol_p;   ///< 圧力変動量の許容変化率
+    REAL_TYPE tol_f;   ///< 物体に働く力の許容変化率
+    REAL_TYPE atol_f;  ///< 物体に働く力の許容変化量（力が0近傍の場合）
+  } Steady_Control;
+  
+  
   /** 偏微分方程式の型 */
   enum PDE_type 
    {
@@ -390,6 +444,21 @@ public:
     Range_Cutoff
   };
   
+  /** 乱流統計テンソルの保持形式 */
+  enum stat_storage
+  {
+    Stat_Full=0,   ///< セル毎の時間平均
+    Stat_Packed    ///< x-z面平均プロファイルのみ
+  };
+  
+  /** 熱の多重時間刻み */
+  enum heat_subcycle
+  {
+    Subcycle_off=0,  ///< 流れと同じΔt
+    Subcycle_step,   ///< 指定ステップ数毎
+    Subcycle_dfn     ///< 拡散数制限から間隔を決定
+  };
+  
   /** 出力タイミングの指定 */
   enum output_mode 
   {
@@ -470,6 +539,8 @@ public:
   int CheckParam;
   int CnvScheme;
   int GuideOut;
+  int HeatSubcycle;   ///< 熱の多重時間刻みのモード
+  int HeatInterval;   ///< 熱の時間進行の間隔 [流れのステップ数]
   int KindOfSolver;
   int Limiter;
   int MarchingScheme;
@@ -493,8 +564,12 @@ public:
   
   unsigned Restart_staging;    ///< リスタート時にリスタートファイルがSTAGINGされているか
   unsigned long NoWallSurface; ///< 固体表面セル数
+  unsigned long LogBufferSize; ///< バイナリ履歴出力のバッファサイズ [byte]
+  unsigned long TraceBufferSize; ///< イベントトレースのスレッドあたりのバッファサイズ [byte]
 	
   double Tscale;
+  double HwPeakFlops;    ///< ルーフライン分類に用いるプロセスあたりのピーク演算性能 [FLOP/s]
+  double HwPeakBW;       ///< ルーフライン分類に用いるプロセスあたりのピークメモリバンド幅 [Byte/s]
   
   bool varState[var_END]; ///< 変数のActive/Inactive
   
@@ -536,6 +611,7 @@ public:
   Ens_of_Compo      EnsCompo;
   Driver_Def        drv;
   Stability_Control Stab;
+  Steady_Control    SteadyAcc;
   
   // class
   IntervalManager Interval[tg_END];  ///< タイミング制御
@@ -559,6 +635,8 @@ public:
     CheckParam = 0;
     CnvScheme = 0;
     GuideOut = 0;
+    HeatSubcycle = Subcycle_off;
+    HeatInterval = 1;
     KindOfSolver = 0;
     Limiter = 0;
     MarchingScheme = 0;
@@ -571,6 +649,8 @@ public:
     NoMediumFluid = 0;
     NoMediumSolid = 0;
     NoWallSurface = 0;
+    LogBufferSize = 0;
+    TraceBufferSize = 0;
     num_process = 0;
     num_thread = 0;
     Parallelism = 0;
@@ -588,6 +668,8 @@ public:
     Gravity = Mach = SpecificHeatRatio =  0.0;
     timeflag = 0.0;
     Tscale = 0.0;
+    HwPeakFlops = 0.0;
+    HwPeakBW = 0.0;
     
     for (int i=0; i<NOFACE; i++) {
       OpenDomain[i]=0.0;
@@ -614,9 +696,12 @@ public:
     Mode.Example = 0;
     Mode.Log_Base = 0;
     Mode.Log_Wall = 0;
+    Mode.Log_Format = 0;
     Mode.PDE = 0;
     Mode.Precision = 0;
     Mode.Profiling = 0;
+    Mode.Trace = 0;
+    Mode.HwCounter = 0;
     Mode.PrsNeuamnnType = 0;
     Mode.ShapeAprx = 0;
     Mode.Steady = 0;
@@ -627,6 +712,7 @@ public:
     Mode.ReynoldsStress = 0;
     Mode.ChannelOutputIter = 0;
     Mode.ChannelOutputMean = 0;
+    Mode.StatStorage = 0;
 
     LES.Calc=0;
     LES.Model=0;
@@ -652,6 +738,18 @@ public:
     Stab.end   = 0.0;
     Stab.penalty_number = 0.0;
     
+    SteadyAcc.lts       = OFF;
+    SteadyAcc.smooth    = OFF;
+    SteadyAcc.sweep     = 2;
+    SteadyAcc.terminate = OFF;
+    SteadyAcc.window    = 100;
+    SteadyAcc.ratio     = 10.0;
+    SteadyAcc.eps       = 0.5;
+    SteadyAcc.tol_v     = 1.0e-3;
+    SteadyAcc.tol_p     = 1.0e-3;
+    SteadyAcc.tol_f     = 1.0e-3;
+    SteadyAcc.atol_f    = 1.0e-6;
+    
     Unit.Param  = 0;
     Unit.Output = 0;
     Unit.Prs    = 0;
@@ -727,6 +825,10 @@ protected:
   void getSolverProperties ();
   
   
+  // 定常解の加速と自動終了のパラメータを取得する
+  void getSteadyAcceleration();
+  
+  
   // 時間制御に関するパラメータを取得する
   void getTimeControl(DTcntl* DT);
   
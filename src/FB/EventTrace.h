@@ -0,0 +1,230 @@
+#ifndef _FB_EVENT_TRACE_H_
+#define _FB_EVENT_TRACE_H_
+
+//##################################################################################
+//
+// Flow Base class
+//
+// Copyright (c) 2007-2011 VCAD System Research Program, RIKEN.
+// All rights reserved.
+//
+// Copyright (c) 2011-2015 Institute of Industrial Science, The University of Tokyo.
+// All rights reserved.
+//
+// Copyright (c) 2012-2015 Advanced Institute for Computational Science, RIKEN.
+// All rights reserved.
+//
+//##################################################################################
+
+/**
+ * @file   EventTrace.h
+ * @brief  FlowBase EventTrace class Header
+ * @author aics
+ * @note   TIMING_start/TIMING_stopの区間を時刻付きのイベントとして記録し，
+ *         Chrome trace形式(JSON)で出力する．イベントはスレッド毎に確保したバッファに
+ *         各スレッドが排他なしで書き込み，バッファが半分を超えたとき(flush())と終了時(close())に
+ *         ランク毎のファイルへ書き出す．無効時のコストはisEnabled()の判定のみ
+ */
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <map>
+#include "omp.h"
+
+using namespace std;
+
+
+class EventTrace {
+
+private:
+
+  /// イベント
+  struct Event
+  {
+    double t;          ///< 時刻 [sec]
+    int label;         ///< ラベル番号
+    int ph;            ///< 0:開始, 1:終了
+  };
+
+  /// スレッド毎のバッファ
+  struct Buffer
+  {
+    Event* ev;                ///< イベント配列
+    int n;                    ///< 格納数
+    int open;                 ///< 記録済みで終了していない区間数
+    int depth;                ///< 区間の入れ子の深さ
+    unsigned long long mask;  ///< 深さ毎に開始イベントを記録したかどうか
+    unsigned long long lost;  ///< 捨てたイベント数
+    char pad[64];             ///< false sharing回避
+  };
+
+  bool enabled;              ///< 記録する場合true
+  int myRank;                ///< ランク番号
+  int nThread;               ///< スレッド数
+  int capacity;              ///< スレッドあたりのイベント数
+  double t0;                 ///< 時刻の基準
+  FILE* fp;                  ///< ランク毎の出力ファイル
+  vector<Buffer> buf;        ///< スレッド毎のバッファ
+  vector<string> label;      ///< 登録済みラベル
+  map<string, int> label_id; ///< ラベルから番号への対応
+
+  /// コピー禁止
+  EventTrace(const EventTrace&);
+  EventTrace& operator=(const EventTrace&);
+
+
+public:
+
+  /** コンストラクタ */
+  EventTrace() {
+    enabled  = false;
+    myRank   = 0;
+    nThread  = 0;
+    capacity = 0;
+    t0       = 0.0;
+    fp       = NULL;
+  }
+
+  /** デストラクタ */
+  ~EventTrace() {
+    close();
+  }
+
+
+  /**
+   * @brief 初期化
+   * @param [in] m_rank    ランク番号
+   * @param [in] m_thread  スレッド数
+   * @param [in] m_bufSize スレッドあたりのバッファサイズ [byte]
+   * @retval 成功した場合true
+   * @note 時刻の基準は呼び出し時点．ランク間で揃えるには直前に同期すること
+   */
+  bool initialize(const int m_rank, const int m_thread, const size_t m_bufSize);
+
+
+  /** @brief 記録しているか */
+  bool isEnabled() const
+  {
+    return enabled;
+  }
+
+
+  /**
+   * @brief 区間の開始
+   * @param [in] key ラベル
+   */
+  inline void begin(const string& key)
+  {
+    Buffer& b = buf[ omp_get_thread_num() ];
+    const int d = b.depth++;
+    const int id = findLabel(key);
+
+    // 記録済みの区間の終了イベントの分を残しておく
+    if ( id >= 0 && d < 64 && b.n + b.open + 2 <= capacity )
+    {
+      Event& e = b.ev[b.n++];
+      e.t     = omp_get_wtime() - t0;
+      e.label = id;
+      e.ph    = 0;
+      b.open++;
+      b.mask |= (1ULL << d);
+    }
+    else
+    {
+      if ( d < 64 ) b.mask &= ~(1ULL << d);
+      b.lost++;
+    }
+  }
+
+
+  /**
+   * @brief 区間の終了
+   * @param [in] key ラベル
+   */
+  inline void end(const string& key)
+  {
+    Buffer& b = buf[ omp_get_thread_num() ];
+    const int d = --b.depth;
+
+    if ( d < 0 )
+    {
+      b.depth = 0;
+      return;
+    }
+
+    if ( d < 64 && (b.mask >> d) & 1ULL )
+    {
+      Event& e = b.ev[b.n++];
+      e.t     = omp_get_wtime() - t0;
+      e.label = findLabel(key);
+      e.ph    = 1;
+      b.open--;
+    }
+    else
+    {
+      b.lost++;
+    }
+  }
+
+
+  /**
+   * @brief 書き出しが必要か
+   * @retval いずれかのスレッドのバッファが半分を超えた場合true
+   */
+  bool needFlush() const;
+
+
+  /**
+   * @brief バッファの内容をファイルに書き出す
+   * @note 並列領域の外から呼ぶこと
+   */
+  void flush();
+
+
+  /**
+   * @brief 書き出して終了
+   * @retval 捨てたイベント数
+   */
+  unsigned long long close();
+
+
+  /**
+   * @brief ランク毎のファイルを1つのファイルにまとめる
+   * @param [in] filename まとめたファイル名
+   * @param [in] nRank    ランク数
+   * @retval 成功した場合true
+   * @note 全ランクがclose()した後にマスターランクで呼ぶ．まとめたランク毎のファイルは削除する
+   */
+  static bool merge(const char* filename, const int nRank);
+
+
+  /**
+   * @brief ランク毎のファイル名
+   * @param [in] rank ランク番号
+   */
+  static string rankFileName(const int rank);
+
+
+private:
+
+  /**
+   * @brief ラベルの番号
+   * @param [in] key ラベル
+   * @retval ラベル番号，登録できない場合-1
+   * @note 未登録のラベルは並列領域の外でのみ登録する
+   */
+  inline int findLabel(const string& key)
+  {
+    map<string, int>::const_iterator it = label_id.find(key);
+    if ( it != label_id.end() ) return it->second;
+    if ( omp_in_parallel() ) return -1;
+
+    const int id = (int)label.size();
+    label.push_back(key);
+    label_id[key] = id;
+    return id;
+  }
+};
+
+#endif // _FB_EVENT_TRACE_H_
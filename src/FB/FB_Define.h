@@ -92,6 +92,10 @@
 #define GMRES         4
 #define PCG           5
 #define BiCGSTAB      6
+#define CHEBYSHEV     7
+#define LINE_SOR      8
+#define FFT_POISSON   9
+#define SOR2CS        10
 
 #define FREQ_OF_RESTART 15 // リスタート周期
 
@@ -217,6 +221,9 @@
 #define ACTIVE_BIT 31
 #define STATE_BIT  30
 
+// コンポーネントのセルリストの面フラグ 0-5ビットは各方向(DIRection)
+#define CELL_SELF  6 //  自セルがコンポーネントに属する
+
 // エンコードビット B
 #define FORCING_BIT   28 //  外力モデルの識別子
 #define TOP_VF        20 //  Volume Fractionの先頭ビット
@@ -567,6 +574,12 @@ enum Synch_Mode {
   comm_async
 };
 
+/// 収束判定の集約モード
+enum Check_Mode {
+  chk_blocking=1, ///< 判定する反復で集約を待つ
+  chk_lagged      ///< 非ブロッキングで集約し，次の反復で判定
+};
+
 /// send/recv Key
 enum CommKeys {
   key_send=0,
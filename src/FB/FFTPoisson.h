@@ -0,0 +1,228 @@
+#ifndef _FB_FFT_POISSON_H_
+#define _FB_FFT_POISSON_H_
+
+//##################################################################################
+//
+// Flow Base class
+//
+// Copyright (c) 2007-2011 VCAD System Research Program, RIKEN.
+// All rights reserved.
+//
+// Copyright (c) 2011-2015 Institute of Industrial Science, The University of Tokyo.
+// All rights reserved.
+//
+// Copyright (c) 2012-2015 Advanced Institute for Computational Science, RIKEN.
+// All rights reserved.
+//
+//##################################################################################
+
+/**
+ * @file   FFTPoisson.h
+ * @brief  FlowBase FFTPoisson class Header
+ * @author aics
+ * @note   障害物のない等間隔格子上の圧力Poisson方程式（blas_calc_axと同じ離散化）を
+ *         高速フーリエ変換による対角化で直接解く．各方向の外部境界は周期，Neumann，Dirichletの
+ *         いずれか（両端が周期の場合を除き，両端の組み合わせは任意）．
+ *         Neumann/Dirichletの方向は偶・奇拡張した周期列の複素FFTで実数変換を行う．
+ *         変換は方向毎に，その方向の分割のランク間でAlltoallvにより全長のライン（ペンシル）を
+ *         分配して行う．FFTは混合基数（2,3,4,5と一般の素因数）で外部ライブラリを使わない
+ */
+
+#include <stdio.h>
+#include <vector>
+#include "omp.h"
+#include <complex>
+#include "mpi.h"
+#include "omp.h"
+#include "FB_Define.h"
+
+using namespace std;
+
+
+class FFTPoisson {
+
+public:
+  /// 外部境界の種類
+  enum fft_bc
+  {
+    fft_periodic=0, ///< 周期
+    fft_neumann,    ///< 勾配ゼロ
+    fft_dirichlet   ///< 値ゼロ（非零の値はRHSに含まれる）
+  };
+
+private:
+
+  typedef complex<double> cplx;
+
+  /// 1方向の変換
+  struct Transform
+  {
+    int n;                ///< 全体のセル数
+    int m;                ///< 複素FFTの長さ (周期 n, 同種の境界 2n, 異種の境界 4n)
+    int lo;               ///< 左端の境界
+    int hi;               ///< 右端の境界
+    vector<int> fac;      ///< mの因数
+    vector<cplx> tw;      ///< 回転因子 exp(-2 pi i k/m)
+    vector<cplx> ph;      ///< 位相 exp(-i pi k/m)
+    vector<double> lambda; ///< 波数毎の固有値（格子幅の比を含む）
+    int rmax;             ///< 一般の基数（4, 2以外）の最大値，無い場合0
+    mutable vector<cplx> wk; ///< 一般の基数のバタフライの作業配列 [スレッド数*rmax]
+  };
+
+  /// 方向毎のペンシル転置の情報
+  struct Pencil
+  {
+    MPI_Comm comm;        ///< その方向に並ぶランクのコミュニケータ
+    int np;               ///< ランク数
+    int nl;               ///< ブロック内のライン数
+    vector<int> len;      ///< 各ランクのライン方向のセル数
+    vector<int> ofs;      ///< 各ランクのライン方向の開始位置
+    vector<int> lst;      ///< 各ランクが受け持つラインの開始番号 [np+1]
+    vector<int> s_cnt, s_dsp, r_cnt, r_dsp; ///< Alltoallvの要素数と変位
+  };
+
+  bool ready;             ///< 初期化済みの場合true
+  int sz[3];              ///< ローカルのセル数
+  int gd;                 ///< ガイドセル数
+  int head[3];            ///< ローカルの開始インデクス（0始まりのグローバル）
+  Transform tr[3];        ///< 方向毎の変換
+  Pencil pc[3];           ///< 方向毎のペンシル転置
+
+  vector<double> blk;     ///< ブロック配置の作業配列 [sz[0]*sz[1]*sz[2]]
+  vector<double> s_buf;   ///< 送信バッファ
+  vector<double> r_buf;   ///< 受信バッファ（ペンシル配置，送信元ランク毎にライン順）
+
+  /// コピー禁止
+  FFTPoisson(const FFTPoisson&);
+  FFTPoisson& operator=(const FFTPoisson&);
+
+
+public:
+
+  /** コンストラクタ */
+  FFTPoisson() {
+    ready = false;
+    gd = 0;
+    for (int i=0; i<3; i++)
+    {
+      sz[i] = 0;
+      head[i] = 0;
+      pc[i].comm = MPI_COMM_NULL;
+      pc[i].np = 0;
+      pc[i].nl = 0;
+      tr[i].rmax = 0;
+    }
+  }
+
+  /** デストラクタ */
+  ~FFTPoisson() {
+    release();
+  }
+
+
+  /**
+   * @brief 初期化
+   * @param [in] comm    コミュニケータ
+   * @param [in] m_gsz   全体のセル数
+   * @param [in] m_sz    ローカルのセル数
+   * @param [in] m_head  ローカルの開始インデクス（1始まり）
+   * @param [in] m_gd    ガイドセル数
+   * @param [in] m_dh    格子幅
+   * @param [in] m_bc    外部境界の種類 [X_minus, X_plus, Y_minus, Y_plus, Z_minus, Z_plus]
+   * @retval 領域が直方体のテンソル積分割で，境界の指定が正しい場合true
+   * @note 全ランクで呼ぶ．各方向に並ぶランクのサブコミュニケータを作る
+   */
+  bool initialize(MPI_Comm comm,
+                  const int* m_gsz,
+                  const int* m_sz,
+                  const int* m_head,
+                  const int m_gd,
+                  const REAL_TYPE* m_dh,
+                  const int* m_bc);
+
+
+  /** @brief 初期化済みか */
+  bool isReady() const
+  {
+    return ready;
+  }
+
+
+  /**
+   * @brief A x = b を解く
+   * @param [out] x   解ベクトル（内部セルのみ更新）
+   * @param [in]  b   RHS vector
+   * @param [in]  cm  Limited Compressibilityのときの係数 (dh * Mach / dt)
+   * @retval 演算数の見積もり
+   * @note Aはblas_calc_axと同じ ss - dd x．全方向に零固有値がある場合は平均値ゼロの解
+   */
+  double solve(REAL_TYPE* x, const REAL_TYPE* b, const REAL_TYPE cm);
+
+
+  /** @brief サブコミュニケータと作業配列の解放 */
+  void release();
+
+
+private:
+
+  /**
+   * @brief 1方向の変換の準備
+   * @param [out] t   変換
+   * @param [in]  n   全体のセル数
+   * @param [in]  lo  左端の境界
+   * @param [in]  hi  右端の境界
+   * @param [in]  r2  格子幅の比の自乗
+   */
+  static void setTransform(Transform& t, const int n, const int lo, const int hi, const double r2);
+
+
+  /**
+   * @brief 混合基数の複素FFT（再帰，時間間引き）
+   * @param [out] out  出力
+   * @param [in]  in   入力
+   * @param [in]  n    この段の長さ
+   * @param [in]  st   入力のストライド
+   * @param [in]  f    因数の配列
+   * @param [in]  t    変換
+   * @param [in]  inv  逆変換の場合true（正規化しない）
+   * @note 一般の基数の作業配列は t.wk のスレッド毎の区画を使う
+   */
+  static void fft(cplx* out, const cplx* in, const int n, const int st, const int* f, const Transform& t, const bool inv);
+
+
+  /**
+   * @brief 1本のラインの実数変換
+   * @param [in,out] x    ライン（長さ t.n）
+   * @param [in]     t    変換
+   * @param [in]     inv  逆変換の場合true
+   * @param [in]     y    作業配列（長さ t.m）
+   * @param [in]     z    作業配列（長さ t.m）
+   */
+  static void lineTransform(double* x, const Transform& t, const bool inv, cplx* y, cplx* z);
+
+
+  /**
+   * @brief ブロック配置からペンシル配置への転置
+   * @param [in] d  方向
+   */
+  void toPencil(const int d);
+
+
+  /**
+   * @brief ペンシル配置からブロック配置への転置
+   * @param [in] d  方向
+   */
+  void fromPencil(const int d);
+
+
+  /**
+   * @brief ペンシル配置の全ラインを変換
+   * @param [in] d     方向
+   * @param [in] mode  0 順変換, 1 逆変換, 2 順変換・固有値で除算・逆変換（z方向のみ）
+   * @param [in] cf    cm^2（mode 2で使う）
+   * @retval 演算数の見積もり
+   */
+  double transformLines(const int d, const int mode, const double cf);
+};
+
+#endif // _FB_FFT_POISSON_H_
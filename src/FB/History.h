@@ -27,6 +27,7 @@
 #include "Component.h"
 #include "FBUtility.h"
 #include "Vec3.h"
+#include "LogChannel.h"
 
 #define CCNV_MAX 20
 
@@ -50,6 +51,8 @@ protected:
   int Unit_Prs;              ///< 圧力基準モード
   int Unit_Log;              ///< ログ出力の単位
   int NoCompo;               ///< コンポネント数
+  int heat_sub;              ///< このステップの熱の時間進行がまとめた流れのステップ数（0は省略）
+  double heat_saved;         ///< 省略した熱の時間進行の割合 [%]
   
   // CCNVファイル名（固定）
   char ccnvfile[16];
@@ -79,6 +82,8 @@ public:
     time  = 0.0;
     v_max = 0.0;
     step  = 0;
+    heat_sub   = 1;
+    heat_saved = 0.0;
     
     // ファイル名（固定）
     memset(ccnvfile, 0, sizeof(char)*16);
@@ -244,7 +249,7 @@ public:
   
   /**
    * @brief 標準履歴の出力
-   * @param [in] fp         出力ファイルポインタ
+   * @param [in] ch         出力先
    * @param [in] rms        1タイムステップの変化量　（0-pressure, 1-velocity, 2-temperature)
    * @param [in] avr        1タイムステップの平均値　（0-pressure, 1-velocity, 2-temperature)
    * @param [in] container  反復回数，残差，エラー
@@ -253,7 +258,7 @@ public:
    * @param [in] stptm      1タイムステップの計算時間
    * @param [in] disp       計算時間表示の有無
    */
-  void printHistory(FILE* fp,
+  void printHistory(LogChannel* ch,
                     const double* rms,
                     const double* avr,
                     const double* container,
@@ -265,49 +270,49 @@ public:
   
   /**
    * @brief 反復過程の状況モニタのヘッダー出力
-   * @param [in] fp        出力ファイルポインタ
+   * @param [in] ch        出力先
    * @param [in] container Res, Errの型
    * @param [in] C         制御クラス
    * @param [in] DC        無次元発散値収束判定パラメータ
    * @param [in] disp      計算時間表示の有無
    */
-  void printHistoryTitle(FILE* fp, const int* container, const Control* C, const DivConvergence* DC, const bool disp);
+  void printHistoryTitle(LogChannel* ch, const int* container, const Control* C, const DivConvergence* DC, const bool disp);
   
   
   /**
    * @brief コンポーネントモニタの履歴出力
-   * @param [in] fp  出力ファイルポインタ
+   * @param [in] ch  出力先
    * @param [in] cmp CompoListクラスのポインタ
    * @param [in] C   Controlクラスへのポインタ
    * @param [in] dt  無次元時間積分幅
    */
-  void printHistoryCompo(FILE* fp, const CompoList* cmp, const Control* C, const REAL_TYPE dt);
+  void printHistoryCompo(LogChannel* ch, const CompoList* cmp, const Control* C, const REAL_TYPE dt);
   
   
   /**
    * @brief コンポーネントモニタのヘッダー出力
-   * @param [in] fp  出力ファイルポインタ
+   * @param [in] ch  出力先
    * @param [in] cmp CompoListクラスのポインタ
    * @param [in] C   Controlクラスへのポインタ
    */
-  void printHistoryCompoTitle(FILE* fp, const CompoList* cmp, const Control* C);
+  void printHistoryCompoTitle(LogChannel* ch, const CompoList* cmp, const Control* C);
   
   
   /**
    * @brief 計算領域の流束履歴の出力
-   * @param [in] fp 出力ファイルポインタ
+   * @param [in] ch 出力先
    * @param [in] C  Controlクラスへのポインタ
    * @param [in] dt 無次元時間積分幅
    */
-  void printHistoryDomfx(FILE* fp, const Control* C, const REAL_TYPE dt);
+  void printHistoryDomfx(LogChannel* ch, const Control* C, const REAL_TYPE dt);
   
   
   /**
    * @brief 計算領域の流束履歴のヘッダー出力
-   * @param [in] fp 出力ファイルポインタ
+   * @param [in] ch 出力先
    * @param [in] C  コントロールクラス
    */
-  void printHistoryDomfxTitle(FILE* fp, const Control* C);
+  void printHistoryDomfxTitle(LogChannel* ch, const Control* C);
   
   
   /**
@@ -328,18 +333,18 @@ public:
   
   /**
    * @brief 壁面履歴の出力
-   * @param [in] fp        出力ファイルポインタ
+   * @param [in] ch        出力先
    * @param [in] range_Yp  壁座標の最小最大値
    * @param [in] range_Ut  摩擦速度の最小最大値
    */
-  void printHistoryWall(FILE* fp, const REAL_TYPE* range_Yp, const REAL_TYPE* range_Ut);
+  void printHistoryWall(LogChannel* ch, const REAL_TYPE* range_Yp, const REAL_TYPE* range_Ut);
   
   
   /**
    * @brief 壁面履歴のヘッダール出力
-   * @param [in] fp        出力ファイルポインタ
+   * @param [in] ch        出力先
    */
-  void printHistoryWallTitle(FILE* fp);
+  void printHistoryWallTitle(LogChannel* ch);
   
   
   /**
@@ -351,6 +356,18 @@ public:
   void updateTimeStamp(const int m_stp, const REAL_TYPE m_tm, const REAL_TYPE vMax);
   
   
+  /**
+   * @brief 熱の多重時間刻みの状態を更新
+   * @param [in] m_sub   このステップの熱の時間進行がまとめた流れのステップ数（0は省略）
+   * @param [in] m_saved 省略した熱の時間進行の割合 [%]
+   */
+  void updateHeatSubcycle(const int m_sub, const double m_saved)
+  {
+    heat_sub   = m_sub;
+    heat_saved = m_saved;
+  }
+  
+  
   /**
    * @brief 物体に働く力の統計量を出力
    * @param [in] cmp CompoListクラスのポインタ
@@ -0,0 +1,210 @@
+#ifndef _FB_HW_COUNTER_H_
+#define _FB_HW_COUNTER_H_
+
+//##################################################################################
+//
+// Flow Base class
+//
+// Copyright (c) 2007-2011 VCAD System Research Program, RIKEN.
+// All rights reserved.
+//
+// Copyright (c) 2011-2015 Institute of Industrial Science, The University of Tokyo.
+// All rights reserved.
+//
+// Copyright (c) 2012-2015 Advanced Institute for Computational Science, RIKEN.
+// All rights reserved.
+//
+//##################################################################################
+
+/**
+ * @file   HwCounter.h
+ * @brief  FlowBase HwCounter class Header
+ * @author aics
+ * @note   PMlibの測定区間毎にハードウェアカウンタ(Linux perf_event)の値を積算する．
+ *         カウンタは各OpenMPスレッドが自スレッドに対して開き，区間の開始と終了で
+ *         全スレッドの値を読んで差分を加える．区間の値は入れ子の内側を含む(inclusive)．
+ *         浮動小数点演算数はx86のFP_ARITH_INST_RETIREDを幅で重み付けした値，
+ *         メモリ転送量は最終レベルキャッシュのミス数×ラインサイズで見積もる．
+ *         カウンタが使えない環境では該当欄を表示しない
+ */
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <map>
+#include "omp.h"
+#include "cpm_ParaManager.h"
+
+using namespace std;
+
+
+class HwCounter {
+
+public:
+  /// カウンタの種類
+  enum hw_event
+  {
+    hw_cycles=0,   ///< サイクル数
+    hw_instr,      ///< 命令数
+    hw_llc_miss,   ///< 最終レベルキャッシュミス数
+    hw_fp_scalar,  ///< スカラ演算命令
+    hw_fp_128,     ///< 128bit SIMD演算命令
+    hw_fp_256,     ///< 256bit SIMD演算命令
+    hw_fp_512,     ///< 512bit SIMD演算命令
+    hw_END
+  };
+
+private:
+
+  /// 測定区間
+  struct Section
+  {
+    string name;          ///< ラベル
+    bool calc;            ///< 計算区間の場合true (PerfMonitor::CALC)
+    int depth;            ///< 入れ子の深さ
+    double time;          ///< 積算時間 [sec]
+    double flop_est;      ///< TIMING_stopに与えられた演算数の積算
+    double t_start;       ///< 開始時刻
+    double cnt[hw_END];   ///< カウンタの積算値
+    double c_start[hw_END]; ///< 開始時のカウンタ値
+  };
+
+  bool enabled;           ///< 測定する場合true
+  int nThread;            ///< スレッド数
+  vector<int> fd;         ///< ファイルディスクリプタ [nThread * hw_END]，開けない場合は-1
+  bool avail[hw_END];     ///< 全スレッドで有効なカウンタ
+  double peakFlops;       ///< プロセスあたりのピーク演算性能 [FLOP/s]
+  double peakBW;          ///< プロセスあたりのピークメモリバンド幅 [Byte/s]
+  vector<Section> sec;    ///< 測定区間
+  map<string, int> sec_id; ///< ラベルから区間番号への対応
+
+  /// コピー禁止
+  HwCounter(const HwCounter&);
+  HwCounter& operator=(const HwCounter&);
+
+
+public:
+
+  /** コンストラクタ */
+  HwCounter() {
+    enabled   = false;
+    nThread   = 0;
+    peakFlops = 0.0;
+    peakBW    = 0.0;
+    for (int i=0; i<hw_END; i++) avail[i] = false;
+  }
+
+  /** デストラクタ */
+  ~HwCounter() {
+    close();
+  }
+
+
+  /**
+   * @brief 初期化
+   * @param [in] m_peakFlops プロセスあたりのピーク演算性能 [FLOP/s] (0の場合は既定のバランス)
+   * @param [in] m_peakBW    プロセスあたりのピークメモリバンド幅 [Byte/s]
+   * @retval いずれかのカウンタが使える場合true
+   * @note 並列領域の外で呼ぶ．各スレッドが自スレッドのカウンタを開く
+   */
+  bool initialize(const double m_peakFlops, const double m_peakBW);
+
+
+  /** @brief 測定しているか */
+  bool isEnabled() const
+  {
+    return enabled;
+  }
+
+
+  /**
+   * @brief ラベルの登録
+   * @param [in] key  ラベル
+   * @param [in] calc 計算区間の場合true
+   * @note 全ランクで同じ順に登録すること
+   */
+  void registerLabel(const string& key, const bool calc);
+
+
+  /**
+   * @brief 区間の開始
+   * @param [in] key ラベル
+   */
+  inline void start(const string& key)
+  {
+    map<string, int>::const_iterator it = sec_id.find(key);
+    if ( it == sec_id.end() ) return;
+
+    Section& s = sec[it->second];
+
+    if ( s.depth++ == 0 )
+    {
+      readAll(s.c_start);
+      s.t_start = omp_get_wtime();
+    }
+  }
+
+
+  /**
+   * @brief 区間の終了
+   * @param [in] key  ラベル
+   * @param [in] flop 見積もりの演算数
+   */
+  inline void stop(const string& key, const double flop)
+  {
+    map<string, int>::const_iterator it = sec_id.find(key);
+    if ( it == sec_id.end() ) return;
+
+    Section& s = sec[it->second];
+    s.flop_est += flop;
+
+    if ( s.depth == 0 ) return;
+
+    if ( --s.depth == 0 )
+    {
+      double c[hw_END];
+      s.time += omp_get_wtime() - s.t_start;
+      readAll(c);
+      for (int i=0; i<hw_END; i++) s.cnt[i] += c[i] - s.c_start[i];
+    }
+  }
+
+
+  /**
+   * @brief 全ランクの値を集計
+   * @param [in] paraMngr cpm_ParaManagerクラス
+   * @param [in] procGrp  プロセスグループ番号
+   * @note 時間はランクの最大値，カウンタと演算数は総和．全ランクで呼ぶこと
+   */
+  void gather(cpm_ParaManager* paraMngr, const int procGrp);
+
+
+  /**
+   * @brief 区間毎の結果と律速の分類を出力
+   * @param [in] fp      出力ファイルポインタ
+   * @param [in] numProc ランク数
+   */
+  void print(FILE* fp, const int numProc);
+
+
+  /** @brief カウンタを閉じる */
+  void close();
+
+
+private:
+
+  /**
+   * @brief 全スレッドのカウンタ値の和
+   * @param [out] v カウンタ値（多重化の場合は稼働時間で補正）
+   */
+  void readAll(double* v);
+
+
+  /**
+   * @brief 区間の演算数（計測値）
+   * @param [in] s 区間
+   */
+  double measuredFlop(const Section& s) const;
+};
+
+#endif // _FB_HW_COUNTER_H_
@@ -29,6 +29,7 @@
 #include <stdio.h>
 #include <strings.h>
 #include "TextParser.h"
+#include "mpi.h"
 
 using namespace std;
 
@@ -51,8 +52,30 @@ protected:
   int Sync;             ///< 同期モード (comm_sync, comm_async)
   int precondition;     ///< 前処理mode
   int InnerItr;         ///< 内部反復回数
+  int Restart;          ///< GMRESのリスタート周期
+  int Recycle;          ///< GCRO-DRの再利用部分空間の次元（0の場合は再利用しない）
+  double EigenRatio;    ///< Chebyshev反復の固有値の比 lambda_max/lambda_min
+  int LineDir;          ///< ライン緩和の方向 (0:自動, 1:x, 2:y, 3:z)
+  int CheckMode;        ///< 収束判定の集約モード (chk_blocking, chk_lagged)
+  int CheckInterval;    ///< 収束判定の間隔（適応の場合は上限）
+  bool CheckAdaptive;   ///< 収束率から判定間隔を予測する場合true
+  bool OmegaAdaptive;   ///< 収束率から加速係数を推定する場合true
   string alias;         ///< 別名
   
+  MPI_Request cv_req;   ///< 遅延判定の集約要求
+  double cv_snd[3];     ///< 遅延判定の送信値
+  double cv_rcv[3];     ///< 遅延判定の集約値
+  int cv_pending;       ///< 集約中の反復番号（なければ0）
+  int cv_next;          ///< 次に判定する反復番号
+  int cv_last;          ///< 前回判定した反復番号
+  double cv_last_res;   ///< 前回判定した残差
+  
+  double om_err;        ///< 加速係数の推定　前回の修正量のL2ノルム
+  double om_rate;       ///< 加速係数の推定　前回の収束率
+  int om_lc;            ///< 加速係数の推定　前回の反復番号
+  int om_stable;        ///< 加速係数の推定　収束率が連続して安定した回数
+  int om_count;         ///< 加速係数を更新した回数
+  
   
 public:
   
@@ -71,8 +94,29 @@ public:
     omg = 0.0;
     Sync = -1;
     InnerItr = 0;
+    Restart = FREQ_OF_RESTART;
+    Recycle = 0;
+    EigenRatio = 30.0;
+    LineDir = 0;
+    CheckMode = chk_blocking;
+    CheckInterval = 1;
+    CheckAdaptive = false;
+    OmegaAdaptive = false;
     smoother = -1;
     
+    cv_req = MPI_REQUEST_NULL;
+    cv_pending = 0;
+    cv_next = 1;
+    cv_last = 0;
+    cv_last_res = 0.0;
+    for (int i=0; i<3; i++) cv_snd[i] = cv_rcv[i] = 0.0;
+    
+    om_err = 0.0;
+    om_rate = 0.0;
+    om_lc = 0;
+    om_stable = 0;
+    om_count = 0;
+    
     eps_err = ( sizeof(REAL_TYPE) == 4 ) ? 4.0*SINGLE_EPSILON : 4.0*DOUBLE_EPSILON;
   }
   
@@ -106,6 +150,27 @@ public:
   }
   
   
+  // @brief Chebyshev反復の固有値の比を返す
+  double getEigenRatio() const
+  {
+    return EigenRatio;
+  }
+  
+  
+  // @brief 収束判定の間隔を返す（適応の場合は上限）
+  int getCheckInterval() const
+  {
+    return CheckInterval;
+  }
+  
+  
+  // @brief 収束判定の集約モードを返す
+  int getCheckMode() const
+  {
+    return CheckMode;
+  }
+  
+  
   // @brief 誤差ノルムの文字列を返す
   string getErrNormString();
   
@@ -138,6 +203,13 @@ public:
   }
   
   
+  // @brief ライン緩和の方向を返す (0:自動)
+  int getLineDir() const
+  {
+    return LineDir;
+  }
+  
+  
   // @brief 線形ソルバの種類を返す
   int getLS() const
   {
@@ -159,10 +231,22 @@ public:
   }
   
   
+  // 収束判定の集約方法と間隔を指定する
+  void getParaCheck(TextParser* tpCntl, const string base);
+  
+  
+  // Chebyshev反復固有のパラメータを指定する
+  void getParaChebyshev(TextParser* tpCntl, const string base);
+  
+  
   // Gmres反復固有のパラメータを指定する
   void getParaGmres(TextParser* tpCntl, const string base);
   
   
+  // ラインSOR反復固有のパラメータを指定する
+  void getParaLineSOR(TextParser* tpCntl, const string base);
+  
+  
   // Jacobi反復固有のパラメータを指定する
   void getParaJacobi(TextParser* tpCntl, const string base);
   
@@ -175,10 +259,28 @@ public:
   void getParaSOR2(TextParser* tpCntl, const string base);
   
   
+  // 色分離配置のRB-SOR反復固有のパラメータを指定する
+  void getParaSOR2CS(TextParser* tpCntl, const string base);
+  
+  
   // Div反復固有のパラメータを指定する
   bool getParaVP(TextParser* tpCntl);
   
   
+  // @brief GMRESのリスタート周期を返す
+  int getRestart() const
+  {
+    return Restart;
+  }
+  
+  
+  // @brief GCRO-DRの再利用部分空間の次元を返す
+  int getRecycle() const
+  {
+    return Recycle;
+  }
+  
+  
   // @brief 残差の収束閾値を返す
   double getResCriterion() const
   {
@@ -218,6 +320,41 @@ public:
   }
   
   
+  // @brief 収束判定の間隔を適応的に決めるか
+  bool isCheckAdaptive() const
+  {
+    return CheckAdaptive;
+  }
+  
+  
+  // @brief 加速係数を適応的に推定するか
+  bool isOmegaAdaptive() const
+  {
+    return OmegaAdaptive;
+  }
+  
+  
+  // @brief 加速係数を更新した回数を返す
+  int getOmegaCount() const
+  {
+    return om_count;
+  }
+  
+  
+  // @brief 毎反復で同期集約して判定するか（既定）
+  bool isCheckEveryItr() const
+  {
+    return ( (CheckMode == chk_blocking) && (CheckInterval == 1) && !CheckAdaptive ) ? true : false;
+  }
+  
+  
+  // @brief 反復lcで収束判定を行うか
+  bool isCheckItr(const int lc) const
+  {
+    return (lc >= cv_next) ? true : false;
+  }
+  
+  
   // @brief 前処理の有無を返す
   // @retval true -> preconditioned
   bool isPreconditioned() const
@@ -311,12 +448,69 @@ public:
   }
   
   
+  // @brief 加速係数を保持
+  void setOmega(const double r)
+  {
+    omg = r;
+  }
+  
+  
   // @brief 同期モードを保持
   void setSyncMode(const Synch_Mode r)
   {
     Sync = r;
   }
   
+  
+  // @brief 収束判定の状態を初期化する（反復の開始時に呼ぶ）
+  void resetCheck()
+  {
+    cv_pending = 0;
+    cv_next = CheckAdaptive ? 1 : CheckInterval;
+    cv_last = 0;
+    cv_last_res = 0.0;
+  }
+  
+  
+  /**
+   * @brief 収束判定量の非ブロッキング集約を開始する
+   * @param [in] var   自乗量
+   * @param [in] n     要素数 (<=3)
+   * @param [in] lc    反復番号
+   * @param [in] comm  コミュニケータ
+   */
+  void postCheck(const double* var, const int n, const int lc, MPI_Comm comm);
+  
+  
+  /**
+   * @brief 集約中の判定量の完了を待つ
+   * @retval 集約した反復番号，集約中でなければ0
+   * @param [out] var  集約値
+   * @param [in]  n    要素数 (<=3)
+   */
+  int waitCheck(double* var, const int n);
+  
+  
+  /**
+   * @brief 次に判定する反復を決める
+   * @param [in] lc  判定した反復番号
+   * @note 適応の場合，前回の判定からの収束率で収束までの反復数を予測し，その半分先で判定する
+   */
+  void scheduleCheck(const int lc);
+  
+  
+  /**
+   * @brief 修正量の収束率から加速係数を推定して更新する
+   * @param [in] err  全体の修正量のL2ノルム
+   * @param [in] lc   反復番号
+   * @retval 加速係数を更新した場合true
+   * @note Carré/Hageman-Young 連続する修正量の比をSOR反復行列のスペクトル半径λとみなし，
+   *       (λ+ω-1)^2 = λω^2μ^2 からJacobi反復のスペクトル半径μを得て ω = 2/(1+sqrt(1-μ^2)) とする．
+   *       λが2回続けて安定したときのみ更新する．判定間隔がある場合は間隔で平均した率を使う．
+   *       最初の推定の前にλ = ω-1（ω >= ω_opt）となった場合は，ωを小さくして下から推定し直す
+   */
+  bool tuneOmega(const double err, const int lc);
+  
 };
 
 #endif // _FB_ITERATION_H_
@@ -0,0 +1,180 @@
+#ifndef _FB_LOG_CHANNEL_H_
+#define _FB_LOG_CHANNEL_H_
+
+//##################################################################################
+//
+// Flow Base class
+//
+// Copyright (c) 2007-2011 VCAD System Research Program, RIKEN.
+// All rights reserved.
+//
+// Copyright (c) 2011-2015 Institute of Industrial Science, The University of Tokyo.
+// All rights reserved.
+//
+// Copyright (c) 2012-2015 Advanced Institute for Computational Science, RIKEN.
+// All rights reserved.
+//
+//##################################################################################
+
+/**
+ * @file   LogChannel.h
+ * @brief  FlowBase LogChannel class Header
+ * @author aics
+ * @note   履歴・モニタ出力の出力先．テキストモードではfprintfと同じ．
+ *         バイナリモードでは書式文字列を初回だけ定義レコードとして書き，以降は
+ *         書式番号と引数の値だけをメモリ上のバッファに詰め，バッファが一杯になったとき
+ *         またはクローズ時にまとめて書き出す．書式化は変換時(convert())に行う
+ */
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+class LogChannel {
+
+public:
+  /// 出力形式
+  enum log_format
+  {
+    log_text=0,
+    log_binary
+  };
+
+private:
+
+  /// 登録済みの書式
+  struct Format
+  {
+    const char* ptr;   ///< 書式文字列のアドレス（検索キー）
+    string str;        ///< 書式文字列
+    string args;       ///< 引数の型 ('i':int, 'l':long, 'L':long long, 'd':double, 's':文字列)
+  };
+
+  FILE* fp;            ///< 出力ファイルポインタ
+  bool owner;          ///< このクラスでオープンしたファイルの場合true
+  int mode;            ///< 出力形式
+  size_t bufSize;      ///< バッファを書き出す閾値 [byte]
+  vector<char> buf;    ///< レコードバッファ
+  vector<Format> fmt;  ///< 登録済みの書式
+  int lastHit;         ///< 直前に使った書式番号
+
+  /// コピー禁止
+  LogChannel(const LogChannel&);
+  LogChannel& operator=(const LogChannel&);
+
+
+public:
+
+  /** コンストラクタ */
+  LogChannel() {
+    fp      = NULL;
+    owner   = false;
+    mode    = log_text;
+    bufSize = 0;
+    lastHit = 0;
+  }
+
+  /** デストラクタ */
+  ~LogChannel() {
+    close();
+  }
+
+
+  /**
+   * @brief ファイルをオープン
+   * @param [in] filename  ファイル名
+   * @param [in] m_mode    出力形式
+   * @param [in] m_bufSize バイナリモードのバッファサイズ [byte]
+   * @retval 成功した場合true
+   */
+  bool open(const char* filename, const int m_mode, const size_t m_bufSize);
+
+
+  /**
+   * @brief オープン済みのファイルをテキストモードで割り当てる
+   * @param [in] m_fp ファイルポインタ（クローズはしない）
+   */
+  void attach(FILE* m_fp);
+
+
+  /** @brief オープンされているか */
+  bool isOpen() const
+  {
+    return ( fp != NULL );
+  }
+
+
+  /** @brief バイナリモードか */
+  bool isBinary() const
+  {
+    return ( mode == log_binary );
+  }
+
+
+  /**
+   * @brief 書式付き出力
+   * @param [in] format 書式文字列
+   * @note  バイナリモードで使える変換指定子は d i u x X o c (h, l, ll修飾可), e E f F g G, s
+   */
+  void print(const char* format, ...);
+
+
+  /**
+   * @brief 出力の区切り
+   * @note  テキストモードではfflush，バイナリモードでは何もしない
+   */
+  void commit();
+
+
+  /** @brief バッファの内容を書き出す */
+  void flush();
+
+
+  /** @brief クローズ */
+  void close();
+
+
+  /**
+   * @brief バイナリ形式のファイルをテキストに変換
+   * @param [in] in  入力ファイルポインタ
+   * @param [in] out 出力ファイルポインタ
+   * @retval 成功した場合true
+   */
+  static bool convert(FILE* in, FILE* out);
+
+
+private:
+
+  /**
+   * @brief 書式の検索と登録
+   * @param [in] format 書式文字列
+   * @retval 書式番号
+   */
+  int findFormat(const char* format);
+
+
+  /**
+   * @brief 書式文字列を解析して引数の型を得る
+   * @param [in]  format 書式文字列
+   * @param [out] args   引数の型
+   * @retval 対応できる書式の場合true
+   */
+  static bool parseFormat(const char* format, string& args);
+
+
+  /**
+   * @brief バッファへ値を追加
+   * @param [in] p     先頭
+   * @param [in] bytes バイト数
+   */
+  void append(const void* p, const size_t bytes)
+  {
+    const char* c = (const char*)p;
+    buf.insert(buf.end(), c, c+bytes);
+  }
+};
+
+#endif // _FB_LOG_CHANNEL_H_
@@ -31,6 +31,7 @@
 #include "Sampling.h"
 #include "FBUtility.h"
 #include "limits.h" // for UBUNTU
+#include "LogChannel.h"
 
 // Graph Ploter
 #define VEC3_EQUATE(A, B) (A[0]=B[0], A[1]=B[1], A[2]=B[2])
@@ -114,7 +115,7 @@ protected:
   int* bcd;            ///< BCindex B
   long long* cut;      ///< 交点情報
   
-  FILE* fp;            ///< 出力ファイルポインタ
+  LogChannel ch;       ///< 出力先
   
   Vec3r* crd;          ///< モニタ点座標配列
   int* rank;           ///< モニタ点担当ランク番号配列
@@ -135,6 +136,26 @@ protected:
   REAL_TYPE* vrSource; ///< 渦度サンプリング元データ
   double* mtbl;        ///< 物性テーブルへのポインタ
   
+  // サンプリングプラン >> 重み付き和で表せるモニタ点は8セルのインデクスと重みに展開しておく
+  bool planReady;      ///< プラン構築済みフラグ
+  int planSize;        ///< プランに展開したモニタ点数
+  int restSize;        ///< Samplingクラスでサンプリングするモニタ点数
+  int* planPoint;      ///< プランに展開したモニタ点番号 [planSize]
+  int* restPoint;      ///< Samplingクラスでサンプリングするモニタ点番号 [restSize]
+  size_t* planIdx;     ///< セルの1次元インデクス [8*planSize]
+  REAL_TYPE* planW;    ///< 重み [8*planSize]
+  REAL_TYPE* planRcp;  ///< 内部エネルギーから温度への係数 1/(rho cp) [8*planSize]
+  unsigned char* planMsk; ///< 渦度計算用の流体フラグ (bit0-5 隣接セル w,e,s,n,b,t, bit6 自セル) [8*planSize]
+  
+  // gather出力 >> 各ランクは担当モニタ点の値だけを送る
+  int nOwn;            ///< 自ランクが担当するモニタ点数
+  int* ownPoint;       ///< 自ランクが担当するモニタ点番号 [nOwn]
+  int* gatherCount;    ///< ランク毎の受信要素数 スカラー[0:np-1], ベクトル[np:2np-1] (ノード0のみ)
+  int* gatherDispl;    ///< ランク毎の受信位置 スカラー[0:np-1], ベクトル[np:2np-1] (ノード0のみ)
+  int* gatherPoint;    ///< 受信順のモニタ点番号 [nPoint] (ノード0のみ)
+  REAL_TYPE* gSendBuf; ///< 送信バッファ [3*nOwn]
+  REAL_TYPE* gRecvBuf; ///< 受信バッファ [3*nPoint] (ノード0のみ)
+  
   // Graph ploter
   REAL_TYPE m_Center[3];
   REAL_TYPE m_MainDir[3];
@@ -169,6 +190,17 @@ public:
     cut = NULL;
     mtbl= NULL;
     
+    planReady = false;
+    planSize = restSize = 0;
+    planPoint = restPoint = NULL;
+    planIdx = NULL;
+    planW = planRcp = NULL;
+    planMsk = NULL;
+    
+    nOwn = 0;
+    ownPoint = gatherCount = gatherDispl = gatherPoint = NULL;
+    gSendBuf = gRecvBuf = NULL;
+    
     // Graph ploter
     setObjType(mon_UNKNOWN);
   }
@@ -212,6 +244,17 @@ public:
     pointStatus = NULL;
     vSource = pSource = tSource = vrSource = NULL;
     
+    planReady = false;
+    planSize = restSize = 0;
+    planPoint = restPoint = NULL;
+    planIdx = NULL;
+    planW = planRcp = NULL;
+    planMsk = NULL;
+    
+    nOwn = 0;
+    ownPoint = gatherCount = gatherDispl = gatherPoint = NULL;
+    gSendBuf = gRecvBuf = NULL;
+    
     this->org = org;
     this->pch = pch;
     this->box = box;
@@ -238,6 +281,14 @@ public:
     if (comment) delete[] comment;
     if (pointStatus) delete[] pointStatus;
     
+    clearPlan();
+    
+    if (ownPoint)    delete[] ownPoint;
+    if (gatherCount) delete[] gatherCount;
+    if (gatherDispl) delete[] gatherDispl;
+    if (gatherPoint) delete[] gatherPoint;
+    if (gSendBuf)    delete[] gSendBuf;
+    if (gRecvBuf)    delete[] gRecvBuf;
     
     if (mon)
     {
@@ -368,8 +419,10 @@ public:
   ///
   ///    @param str ファイル名テンプレート
   ///    @param gathered true=gather出力/false=disutribute出力
+  ///    @param format   出力形式 (LogChannel::log_text / log_binary)
+  ///    @param bufSize  バイナリ出力のバッファサイズ [byte]
   ///
-  void openFile(const char* str, const bool gathered);
+  void openFile(const char* str, const bool gathered, const int format, const size_t bufSize);
   
   
   /// モニタ結果出力(distribute)
@@ -640,17 +693,51 @@ protected:
   /// サンプリングしたスカラー変数をノード0に集約
   ///
   ///   @param [in,out] s スカラー変数配列
-  ///   @param  sRecvBuf  通信用work領域
   ///
-  void gatherSampledScalar(REAL_TYPE* s, REAL_TYPE* sRecvBuf);
+  void gatherSampledScalar(REAL_TYPE* s);
   
   
   /// サンプリングしたベクトル変数をノード0に集約
   ///
   ///   @param [in,out] v ベクトル変数配列
-  ///   @param  vSendBuf,vRecvBuf  通信用work領域
   ///
-  void gatherSampledVector(Vec3r* v, REAL_TYPE* vSendBuf, REAL_TYPE* vRecvBuf);
+  void gatherSampledVector(Vec3r* v);
+  
+  
+  /// gather出力の送受信表を作成
+  ///
+  ///   @note rank[]から各ランクの担当モニタ点と受信位置を求める．通信は不要
+  ///
+  void setGatherMap();
+  
+  
+  /// サンプリングプランの構築
+  ///
+  ///   @note bcd[]が確定した後に呼ぶこと
+  ///
+  void buildPlan();
+  
+  
+  /// ステンシルの8セルが全て範囲内にあるか
+  ///
+  ///   @param [in] index ステンシルのセルインデクス
+  ///   @param [in] lo    各方向の下限
+  ///   @param [in] hi_i  i方向の上限
+  ///   @param [in] hi_j  j方向の上限
+  ///   @param [in] hi_k  k方向の上限
+  ///
+  static bool stencilInside(const Vec3i* index, const int lo, const int hi_i, const int hi_j, const int hi_k);
+  
+  
+  /// サンプリングプランの解放
+  void clearPlan();
+  
+  
+  /// サンプリングプランに展開したモニタ点のサンプリング
+  ///
+  ///   @note 全変数を1つのループで処理
+  ///
+  void samplingPlan();
 
   
   
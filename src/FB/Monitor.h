@@ -67,6 +67,8 @@ protected:
   MonitorCompo::ReferenceVariables refVar;  ///< 参照用パラメータ変数
 
   string fname_sampling; ///< 基本ファイル名
+  int logFormat;         ///< 出力形式 (LogChannel::log_text / log_binary)
+  unsigned long logBufSize; ///< バイナリ出力のバッファサイズ [byte]
   
   
 public:
@@ -77,6 +79,8 @@ public:
     outputType = NONE;
     num_process = 0;
     fname_sampling = "sampling.txt";
+    logFormat = LogChannel::log_text;
+    logBufSize = 0;
     area = 0.0;
     NoCompo = 0;
     RefL = 0.0;
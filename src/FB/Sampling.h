@@ -157,6 +157,15 @@ public:
   ///
   virtual REAL_TYPE samplingHelicity(const REAL_TYPE* v) = 0;
   
+  /// サンプリングに使うセルと重みを返す
+  ///
+  ///   @param [out] index セルインデックス (8セル)
+  ///   @param [out] w     重み
+  ///   @return 重み付き和で表せる場合true，それ以外はfalse
+  ///   @note MonitorCompoのサンプリングプランの構築に利用．使わないセルの重みは0
+  ///
+  virtual bool getStencil(Vec3i index[8], REAL_TYPE w[8]) { return false; }
+  
   
 protected:
   /// 全圧を計算
@@ -421,6 +430,13 @@ public:
   ///   @param [in] v サンプリング元速度配列
   ///
   REAL_TYPE samplingHelicity(const REAL_TYPE* v);
+  
+  /// サンプリングに使うセルと重みを返す
+  ///
+  ///   @param [out] index セルインデックス (8セル)
+  ///   @param [out] w     重み
+  ///
+  bool getStencil(Vec3i index[8], REAL_TYPE w[8]);
 };
 
 
@@ -642,6 +658,13 @@ public:
   ///   @param [in] v サンプリング元速度配列
   ///
   REAL_TYPE samplingHelicity(const REAL_TYPE* v);
+  
+  /// サンプリングに使うセルと重みを返す
+  ///
+  ///   @param [out] index セルインデックス (8セル)
+  ///   @param [out] w     重み
+  ///
+  bool getStencil(Vec3i index[8], REAL_TYPE w[8]);
 };
 
 
@@ -691,6 +714,9 @@ public:
   ///   @param [in] v サンプリング元速度配列
   ///
   Vec3r samplingVelocity(const REAL_TYPE* v);
+  
+  /// 速度の補間セルが成分毎に異なるので，プランには展開しない
+  bool getStencil(Vec3i index[8], REAL_TYPE w[8]) { return false; }
 
 };
 
@@ -308,6 +308,22 @@ public:
                       const int m_NoCompo);
   
   
+  /**
+   * @brief コンポーネントの処理対象セルのリストを作成
+   * @param [in,out] cmp       コンポーネントリスト
+   * @param [in]     bcd       BCindex B
+   * @param [in]     cdf       BCindex C
+   * @param [in]     m_NoCompo コンポーネント数
+   * @retval リストのメモリ量 [byte]
+   * @note 外力コンポーネントはBbox+1層の範囲で自セルか隣接セルがコンポーネントに属すセル，
+   *       内部速度境界はBbox内でいずれかの面がコンポーネントの境界であるセルを登録する
+   */
+  double setCmpCellList(CompoList* cmp,
+                        const int* bcd,
+                        const int* cdf,
+                        const int m_NoCompo);
+  
+  
   /**
    * @brief コンポーネントの操作に必要な定数の設定
    * @param [in] ExRef      組み込み例題クラス
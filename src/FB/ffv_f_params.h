@@ -34,6 +34,7 @@ integer     ::  cmp_typ_outflow, cmp_typ_hex, cmp_typ_vspec, cmp_typ_solidrev
 integer     ::  bc_diag
 integer     ::  gma_T, gma_B, gma_N, gma_S, gma_E, gma_W, h_diag
 integer     ::  top_vf, bitw_8, forcing_bit, bitw_6, bitw_5, bitw_9, bitw_10
+integer     ::  cell_self
 
 parameter ( bc_mask30 = Z'3fffffff') ! 16進表記，VBCの6面(30bit)をまとめたマスク
 parameter ( bitw_10= 10) ! FB_Define.h MASK_10 10bit幅
@@ -57,6 +58,9 @@ parameter ( id_fluid  = 1 ) ! FB_Define.h FLUID
 parameter ( Active  = 31 ) ! FB_Define.h ACTIVE_BIT
 parameter ( State   = 30 ) ! FB_Define.h STATE_BIT
 
+! コンポーネントのセルリストの面フラグ
+parameter ( cell_self = 6 ) ! FB_Define.h CELL_SELF
+
 ! BCindex B
 parameter ( forcing_bit = 28) ! FB_Define.h FORCING_BIT
 parameter ( top_vf      = 20) ! FB_Define.h TOP_VF
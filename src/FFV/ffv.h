@@ -31,6 +31,7 @@
 #include "ffv_Alloc.h"
 #include <math.h>
 #include <float.h>
+#include <vector>
 
 // FB
 #include "omp.h"
@@ -40,6 +41,8 @@
 #include "PolyProperty.h"
 #include "History.h"
 #include "Monitor.h"
+#include "EventTrace.h"
+#include "HwCounter.h"
 
 // FFV
 #include "ffv_Version.h"
@@ -139,6 +142,9 @@ private:
   
   REAL_TYPE deltaT; ///< 時間積分幅（無次元）
   
+  int heatStepCount;       ///< 直前の熱の時間進行からの流れのステップ数
+  unsigned long heatSkipped; ///< 省略した熱の時間進行の回数（セッション）
+  
   int communication_mode; ///< synchronous, asynchronous
   
   REAL_TYPE v00[4];      ///< 参照速度
@@ -147,6 +153,19 @@ private:
   
   DivConvergence DivC; ///< 発散収束判定
   
+  // 射影カーネルで同時に集計する診断量 >> update_vec_diag()
+  std::vector<int> div_cell_list; ///< 発散ノルムの集計から除外したセルのリスト (i, j, k)の3要素の組
+  double diag_local[6];  ///< ローカルな集計値 [発散最大値, 発散自乗和, 速度変化量, 圧力変化量, 圧力和, 速度成分最大値]
+  unsigned diag_step;    ///< diag_localを集計したステップ（0は未集計）
+  double diag_vmax;      ///< 集約済みの速度成分最大値（diag_stepの値）
+  REAL_TYPE diag_v00[3]; ///< diag_vmaxの基準とした参照速度
+  
+  // 定常計算の自動終了 >> chkSteadyState()
+  std::vector<double> steady_hist; ///< 監視量の履歴 [監視量][判定窓]のリングバッファ
+  int steady_nvar;                 ///< 監視量の数（速度，圧力，物体毎の力）
+  unsigned steady_count;           ///< 記録したサンプル数
+  double steady_peak[2];           ///< 速度と圧力の変動量の最大値
+  
   // 定常収束モニタ
   typedef struct
   {
@@ -173,10 +192,11 @@ private:
   int *global_obstacle;        ///< 各コンポーネント毎のOBSTACLEの有無
   int num_obstacle;            ///< OBSTACLEの個数
   
-  FILE *fp_b;  ///< 基本情報
-  FILE *fp_w;  ///< 壁面情報
-  FILE *fp_c;  ///< コンポーネント情報
-  FILE *fp_d;  ///< 流量収支情報
+  LogChannel ch_con; ///< コンソール
+  LogChannel ch_b;   ///< 基本情報
+  LogChannel ch_w;   ///< 壁面情報
+  LogChannel ch_c;   ///< コンポーネント情報
+  LogChannel ch_d;   ///< 流量収支情報
   FILE *fp_i;  ///< 反復履歴情報
   FILE *fp_f;  ///< 力の履歴情報
   
@@ -188,6 +208,8 @@ private:
   MediumList* mat;           ///< 媒質リスト
   CompoList* cmp;            ///< コンポーネントリスト
   PerfMonitor PM;            ///< 性能モニタクラス
+  EventTrace TR;             ///< イベントトレースクラス
+  HwCounter HC;              ///< ハードウェアカウンタクラス
   VoxInfo V;                 ///< ボクセル前処理クラス
   ParseBC B;                 ///< 境界条件のパースクラス
   SetBC3D BC;                ///< BCクラス
@@ -231,6 +253,12 @@ private:
     // PMlib Intrinsic profiler
     TIMING__ PM.start(key);
     
+    // Event trace
+    if ( TR.isEnabled() ) TR.begin(key);
+    
+    // Hardware counter
+    if ( HC.isEnabled() ) HC.start(key);
+    
     const char* s_label = key.c_str();
     
     // Venus FX profiler
@@ -250,6 +278,12 @@ private:
    */
   inline void TIMING_stop(const string key, double flopPerTask=0.0, int iterationCount=1)
   {
+    // Hardware counter
+    if ( HC.isEnabled() ) HC.stop(key, flopPerTask * (double)iterationCount);
+    
+    // Event trace
+    if ( TR.isEnabled() ) TR.end(key);
+    
     // Venus FX profiler
     const char* s_label = key.c_str();
     
@@ -380,6 +414,10 @@ private:
   void setComponentVF();
   
   
+  // 射影カーネルの発散ノルムから除外するセルのリストを作成
+  double setDivCellList();
+  
+  
   // コンポーネントのローカルなBbox情報からグローバルなBbox情報を求め，CompoListの情報を表示
   void dispGlobalCompoInfo(FILE* fp);
   
@@ -438,21 +476,33 @@ private:
   /** ffv.C *******************************************************/
   
   // 時間平均操作を行う
-  void Averaging(double& flop);
+  void Averaging(double& flop, const bool fused);
   
   
   // OBSTACLEコンポーネントの力の成分を計算し、集める
   void calcForce(double& flop);
   
   
+  // 定常状態への収束を判定する
+  bool chkSteadyState(const double* rms);
+  
+  
   // 外部計算領域の各面における総流量と対流流出速度を計算する
   void DomainMonitor(BoundaryOuter* ptr, Control* R);
   
   
+  // 推定した加速係数をリスタート用ファイルから読み込む
+  void loadTunedOmega(FILE* fp);
+  
+  
   // div(u)を計算する
   void NormDiv(REAL_TYPE* div, const REAL_TYPE dt);
   
   
+  // 推定した加速係数をリスタート用ファイルに書き出す
+  void saveTunedOmega(const unsigned step);
+  
+  
   // タイミング測定区間にラベルを与えるラッパー
   void set_label(const string label, PerfMonitor::Type type, bool exclusive=true);
   
@@ -482,10 +532,23 @@ private:
   /**
    * @brief 単媒質に対する熱伝導方程式を陰解法で解く
    * @param [in]  IC       LinearSolverクラス
+   * @param [in]  dt       時間積分幅
    * @param [in]  rhs_nrm  Poisson定数項ベクトルの自乗和ノルム
    * @param [in]  r0       初期残差ベクトル
    */
-  void ps_LS(LinearSolver* IC, const double rhs_nrm, const double r0);
+  void ps_LS(LinearSolver* IC, const REAL_TYPE dt, const double rhs_nrm, const double r0);
+  
+  
+  /**
+   * @brief 熱の反復の収束判定（遅延集約または判定間隔を指定した場合）
+   * @param [in]  IC      LinearSolverクラス
+   * @param [in]  res     ローカルノードの変化量の自乗和
+   * @param [in]  b_l2    Poisson定数項ベクトルの自乗和ノルム
+   * @param [in]  r0_l2   初期残差ベクトル
+   * @param [in]  finish  反復の終了時に集約中の判定量を完了する場合true
+   * @note 判定しない反復では残差を更新しない．反復の開始時に残差を未収束の値にする
+   */
+  void ps_CheckConvergence(LinearSolver* IC, const double res, const double b_l2, const double r0_l2, const bool finish);
 
   
   
@@ -522,8 +585,19 @@ private:
   void NS_FS_E_CDS();
   
   
-  // 温度の移流拡散方程式をEuler陽解法/Adams-Bashforth法で解く
-  void PS_Binary();
+  /**
+   * @brief 温度の移流拡散方程式をEuler陽解法/Adams-Bashforth法で解く
+   * @param [in] dt 時間積分幅
+   * @param [in] vf 対流項に用いるセルフェイス速度
+   */
+  void PS_Binary(const REAL_TYPE dt, REAL_TYPE* vf);
+  
+  
+  /**
+   * @brief 熱の多重時間刻みで保留しているステップ分だけ温度を進める
+   * @param [out] heat_sub まとめた流れのステップ数
+   */
+  void flushHeatSubcycle(int& heat_sub);
 
   
   
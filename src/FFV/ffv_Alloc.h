@@ -54,6 +54,8 @@ public:
   // Main
   REAL_TYPE *d_v;   ///< [*] セルセンター速度
   REAL_TYPE *d_vf;  ///< [*] セルフェイス速度
+  REAL_TYPE *d_vf_h; ///< 熱の多重時間刻みでのセルフェイス速度の区間平均
+  REAL_TYPE *d_vf0; ///<     局所時間刻みでのnステップのセルフェイス速度
   REAL_TYPE *d_p;   ///< [*] 圧力
   REAL_TYPE *d_dv;  ///< [*] \sum{u}の保存
   REAL_TYPE *d_ie;  ///< [*] 内部エネルギー
@@ -114,7 +116,7 @@ public:
 
   
   // 乱流統計量の詳細
-  REAL_TYPE *d_R;          ///< [*] レイノルズ応力テンソル
+  REAL_TYPE *d_R;          ///<     レイノルズ応力テンソル (瞬時値, stat_nr枚のk面を循環して使う)
   REAL_TYPE *d_aR;         ///< [*] レイノルズ応力テンソル (時間平均値)
   REAL_TYPE *d_aP;         ///< [*] 生成項 (時間平均値)
   REAL_TYPE *d_aE;         ///< [*] 散逸項 (時間平均値)
@@ -129,6 +131,11 @@ public:
   REAL_TYPE *d_aT_mean;    ///< [*] 乱流拡散項 (時間・主流方向・スパン方向平均値)
   REAL_TYPE *d_aPI_mean;   ///< [*] 速度圧力勾配相関項 (時間・主流方向・スパン方向平均値)
   
+  int stat_nr;             ///< d_Rが保持するk面の数
+  double *d_prof_sum;      ///<     テンソルのx-z面内総和 (Packed形式, 30成分 x jx)
+  double *d_prof_mean;     ///< [*] テンソルのx-z面平均プロファイルの時間平均値 (Packed形式)
+  double *d_prof_comp;     ///< [*] d_prof_meanの補償項 (Packed形式)
+  
   
   // 界面計算
   REAL_TYPE *d_vof; ///< [*] VOF値
@@ -145,8 +152,10 @@ public:
   // GMRES
   REAL_TYPE * d_wg;   ///< テンポラリの配列 [size]
   REAL_TYPE * d_res;  ///< 残差 = b - Ax
-  REAL_TYPE * d_vm;   ///< Kryolov subspaceの直交基底 [size*FREQ_OF_RESTART]
-  REAL_TYPE * d_zm;   ///< Right-hand side vector for the residual minimization problem [size*FREQ_OF_RESTART]
+  REAL_TYPE * d_vm;   ///< Kryolov subspaceの直交基底 [size*(restart+1)]
+  REAL_TYPE * d_zm;   ///< 前処理後の基底 [size*restart]
+  REAL_TYPE * d_rcu;  ///< GCRO-DRの再利用部分空間の基底 U [size*recycle]
+  REAL_TYPE * d_rcc;  ///< GCRO-DRの C = A U [size*recycle]
   
   
   // PCG & BiCGstab
@@ -167,6 +176,16 @@ public:
   REAL_TYPE *d_pcg_s_;
   REAL_TYPE *d_pcg_t_;
   
+  // Chebyshev
+  REAL_TYPE *d_ch_r;  ///< 残差
+  REAL_TYPE *d_ch_d;  ///< 修正量
+  REAL_TYPE *d_ch_q;  ///< A d
+  
+  // 色分離配置のSOR
+  REAL_TYPE *d_cs_p;  ///< 圧力 [2色, 袖1層]
+  REAL_TYPE *d_cs_b;  ///< RHS [2色]
+  int *d_cs_bp;       ///< BCindex P [2色]
+  
   
   
   
@@ -184,6 +203,8 @@ public:
     
     d_v = NULL;
     d_vf = NULL;
+    d_vf_h = NULL;
+    d_vf0 = NULL;
     d_vc = NULL;
     d_v0 = NULL;
     d_wv = NULL;
@@ -236,6 +257,11 @@ public:
     d_aT_mean   = NULL;
     d_aPI_mean  = NULL;
     
+    stat_nr     = 0;
+    d_prof_sum  = NULL;
+    d_prof_mean = NULL;
+    d_prof_comp = NULL;
+    
     
     d_r_v = NULL;
     d_r_p = NULL;
@@ -245,6 +271,8 @@ public:
     d_res = NULL;
     d_vm = NULL;
     d_zm = NULL;
+    d_rcu = NULL;
+    d_rcc = NULL;
     
     d_pcg_r = NULL;
     d_pcg_p = NULL;
@@ -260,6 +288,14 @@ public:
     d_pcg_s_ = NULL;
     d_pcg_t_ = NULL;
     
+    d_ch_r = NULL;
+    d_ch_d = NULL;
+    d_ch_q = NULL;
+    
+    d_cs_p = NULL;
+    d_cs_b = NULL;
+    d_cs_bp = NULL;
+    
     
     d_cut = NULL;
     d_bid = NULL;
@@ -305,7 +341,7 @@ public:
   
   
   // Krylov-subspace法に用いる配列のアロケーション
-  void allocArray_Krylov(double &total);
+  void allocArray_Krylov(double &total, const int restart);
   
   
   // LES計算に用いる配列のアロケーション
@@ -332,6 +368,34 @@ public:
   void allocArray_BiCGSTABwithPreconditioning(double &total);
   
   
+  // Chebyshev反復に用いる配列のアロケーション
+  void allocArray_Chebyshev(double &total);
+  
+  
+  // FFTによる直接解法に用いる配列のアロケーション
+  void allocArray_FFTPoisson(double &total);
+  
+  
+  // GCRO-DRの再利用部分空間の配列のアロケーション
+  void allocArray_Recycle(double &total, const int recycle);
+  
+  
+  // 色分離配置のSORに用いる配列のアロケーション
+  void allocArray_ColorSplit(double &total);
+  
+  
+  // 熱の陰解法のKrylov部分空間法に用いる配列のアロケーション
+  void allocArray_HeatKrylov(double &total);
+  
+  
+  // 熱の多重時間刻みに用いる配列のアロケーション
+  void allocArray_HeatSubcycle(double &total);
+  
+  
+  // 定常計算の局所時間刻みに用いる配列のアロケーション
+  void allocArray_SteadyLTS(double &total);
+  
+  
   // 前処理に用いる配列のアロケーション
   void allocArray_Prep(double &prep, double &total);
   
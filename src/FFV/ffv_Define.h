@@ -33,5 +33,9 @@
 // PMlibの登録ラベル個数
 #define PM_NUM_MAX 200
 
+// 乱流統計量の融合カーネルで一度に処理するk面の数
+// FALLOC::allocArray_Statistic()
+#define STAT_BLOCK_K 4
+
 
 #endif // _FFV_DEFINE_H_
@@ -21,6 +21,7 @@
  * @author aics
  */
 
+#include <vector>
 #include "cpm_ParaManager.h"
 
 #include "FB_Define.h"
@@ -31,6 +32,9 @@
 #include "ffv_LSfunc.h"
 #include "ffv_SetBC.h"
 #include "FBUtility.h"
+#include "EventTrace.h"
+#include "HwCounter.h"
+#include "FFTPoisson.h"
 
 // FX10 profiler
 #if defined __K_FPCOLL
@@ -53,6 +57,8 @@ private:
   Control* C;        ///< Controlクラス
   SetBC3D* BC;       ///< BCクラス
   PerfMonitor* PM;   ///< PerfMonitor class
+  EventTrace* TR;    ///< EventTrace class
+  HwCounter* HC;     ///< HwCounter class
   int* bcp;          ///< BCindex P
   int* bcd;          ///< BCindex ID
   
@@ -71,6 +77,44 @@ private:
   REAL_TYPE *cf_y;  ///< j方向のバッファ
   REAL_TYPE *cf_z;  ///< k方向のバッファ
   
+  int gm_m;           ///< GMRESのリスタート周期
+  REAL_TYPE* gm_v;    ///< GMRESの直交基底 [size*(gm_m+1)]
+  REAL_TYPE* gm_z;    ///< GMRESの前処理後の基底 [size*gm_m]
+  REAL_TYPE* gm_w;    ///< GMRESのワーク [size]
+  std::vector<double> gm_h;   ///< Hessenberg行列 [(gm_m+1)*gm_m]
+  std::vector<double> gm_cs;  ///< Givens回転のcos
+  std::vector<double> gm_sn;  ///< Givens回転のsin
+  std::vector<double> gm_g;   ///< 最小化問題の右辺
+  std::vector<double> gm_dot; ///< 一括内積のバッファ
+  std::vector<double> gm_tmp; ///< 集約用のバッファ
+  
+  int rc_k;           ///< GCRO-DRの再利用部分空間の次元（0の場合は再利用しない）
+  int rc_n;           ///< 保持している再利用ベクトルの数
+  REAL_TYPE* rc_u;    ///< 再利用部分空間の基底 U [size*rc_k]
+  REAL_TYPE* rc_c;    ///< C = A U，正規直交 [size*rc_k]
+  REAL_TYPE rc_cs;    ///< Cを求めたときのLimited Compressibilityの係数
+  std::vector<double> rc_b;   ///< B = C^T A Z [rc_k*gm_m]
+  std::vector<double> rc_h;   ///< Givens回転前のHessenberg行列 [(gm_m+1)*gm_m]
+  std::vector<double> rc_f;   ///< 調和Ritz問題の V^T W [(rc_k+gm_m+1)*(rc_k+gm_m)]
+  std::vector<double> rc_g;   ///< 調和Ritz問題の G，A W = V G [(rc_k+gm_m+1)*(rc_k+gm_m)]
+  std::vector<double> rc_s;   ///< 調和Ritz問題の作業行列 [(rc_k+gm_m)^2]
+  std::vector<double> rc_q;   ///< 調和Ritz問題の作業行列 [(rc_k+gm_m)^2]
+  std::vector<double> rc_e;   ///< 調和Ritz問題の固有ベクトル [(rc_k+gm_m)^2]
+  
+  REAL_TYPE* ch_r;    ///< Chebyshev反復の残差
+  REAL_TYPE* ch_d;    ///< Chebyshev反復の修正量
+  REAL_TYPE* ch_q;    ///< Chebyshev反復のワーク A d
+  double ch_lmax;     ///< D^{-1}Aの最大固有値の推定値（未推定の場合0）
+  REAL_TYPE ch_cs;    ///< 推定時のLimited Compressibilityの係数
+  
+  FFTPoisson* fft;    ///< FFTによる直接解法（未設定の場合NULL）
+  
+  int cs_hx;          ///< 色分離配置のi方向の内部セル数 (size[0]+1)/2
+  REAL_TYPE* cs_p;    ///< 色分離配置の圧力 [2色, 袖1層]
+  REAL_TYPE* cs_b;    ///< 色分離配置のRHS [2色, 内部のみ]
+  int* cs_bp;         ///< 色分離配置のBCindex P [2色, 内部のみ]
+  bool cs_packed;     ///< BCindex Pを詰めた場合true（反復中は不変なので1回だけ詰める）
+  
 public:
   
   /** コンストラクタ */
@@ -78,6 +122,8 @@ public:
     C   = NULL;
     BC  = NULL;
     PM  = NULL;
+    TR  = NULL;
+    HC  = NULL;
     bcp = NULL;
     bcd = NULL;
     pcg_p  = NULL;
@@ -92,6 +138,26 @@ public:
     cf_x = NULL;
     cf_y = NULL;
     cf_z = NULL;
+    gm_m = 0;
+    gm_v = NULL;
+    gm_z = NULL;
+    gm_w = NULL;
+    rc_k = 0;
+    rc_n = 0;
+    rc_u = NULL;
+    rc_c = NULL;
+    rc_cs = 0.0;
+    ch_r = NULL;
+    ch_d = NULL;
+    ch_q = NULL;
+    ch_lmax = 0.0;
+    ch_cs = 0.0;
+    fft = NULL;
+    cs_hx = 0;
+    cs_p = NULL;
+    cs_b = NULL;
+    cs_bp = NULL;
+    cs_packed = false;
     
     ModeTiming = 0;
     face_comm_size = 0.0;
@@ -104,7 +170,9 @@ public:
   }
   
   /**　デストラクタ */
-  ~LinearSolver() {}
+  ~LinearSolver() {
+    if ( fft ) delete fft;
+  }
   
 
   
@@ -116,16 +184,47 @@ protected:
    * @param [in]  var    誤差、残差、解ベクトルのL2ノルム
    * @param [in]  b_l2   右辺ベクトルのL2ノルム
    * @param [in]  r0_l2  初期残差ベクトルのL2ノルム
+   * @param [in]  m_reduce  varをランク間で集約する場合true（集約済みの場合false）
+   */
+  bool Fcheck(double* var, const double b_l2, const double r0_l2, const bool m_reduce=true);
+  
+  
+  /**
+   * @brief 非Div反復の収束判定（集約モードと判定間隔に従う）
+   * @retval 収束したら true
+   * @param [in]  var    誤差、残差、解ベクトルの自乗量
+   * @param [in]  lc     反復番号
+   * @param [in]  b_l2   右辺ベクトルのL2ノルム
+   * @param [in]  r0_l2  初期残差ベクトルのL2ノルム
+   * @note 遅延モードでは前の判定反復の集約を完了して判定し，この反復の集約を開始する．
+   *       判定は1反復遅れるので，収束後に1回余分に反復する
+   */
+  bool checkConvergence(double* var, const int lc, const double b_l2, const double r0_l2);
+  
+  
+  /**
+   * @brief 反復の終了時に集約中の判定量を完了する
+   * @param [in]  b_l2   右辺ベクトルのL2ノルム
+   * @param [in]  r0_l2  初期残差ベクトルのL2ノルム
+   */
+  void finishCheck(const double b_l2, const double r0_l2);
+  
+  
+  /**
+   * @brief Chebyshev反復の固有値の上限を推定
+   * @param [in] cs  Limited Compressibilityの係数
+   * @note 対角スケーリングした行列 D^{-1}A のべき乗法．未推定か係数が変わった場合のみ行う
    */
-  bool Fcheck(double* var, const double b_l2, const double r0_l2);
+  void ChebyshevBounds(const REAL_TYPE cs);
   
   
   /**
    * @brief Fdot for 1 array
    * @retval  内積値
    * @param [in]   x   vector1
+   * @param [in]   bx  マスクに用いるBCindex（省略時はbcp）
    */
-  double Fdot1(REAL_TYPE* x);
+  double Fdot1(REAL_TYPE* x, int* bx=NULL);
   
   
   /**
@@ -133,8 +232,68 @@ protected:
    * @retval  内積値
    * @param [in]   x   vector1
    * @param [in]   y   vector2
+   * @param [in]   bx  マスクに用いるBCindex（省略時はbcp）
+   */
+  double Fdot2(REAL_TYPE* x, REAL_TYPE* y, int* bx=NULL);
+  
+  
+  /**
+   * @brief GMRESの一括内積 r(0:nc-1) = C^T w, r(nc:nc+nb-1) = V^T w, r(nc+nb) = w^T w
+   * @param [out] r   内積（全ランクの和）
+   * @param [in]  w   ベクトル
+   * @param [in]  nb  基底ベクトルの数
+   * @param [in]  nc  再利用部分空間Cのベクトルの数
+   * @note 基底数によらず集約は1回
+   */
+  void GmresDot(double* r, REAL_TYPE* w, const int nb, const int nc=0);
+  
+  
+  /**
+   * @brief GCRO-DRの再利用部分空間 C = A U を求めて正規直交化する
+   * @param [in] cs  Limited Compressibilityの係数
+   * @note CGS2でCを直交化し，同じ変換をUに適用する．一次従属なベクトルは捨てる
+   */
+  void RecycleBasis(const REAL_TYPE cs);
+  
+  
+  /**
+   * @brief GCRO-DRの再利用部分空間を調和Ritzベクトルで更新する
+   * @param [in] kc  この周期のArnoldiのステップ数
+   * @param [in] cs  Limited Compressibilityの係数
+   * @note W = [U, Z], A W = [C, V] G から，W^T A W g = mu G^T G g （Aは対称）の
+   *       |mu|の大きい（固有値の小さい）rc_k個のベクトル W g を新しいUとする
+   */
+  void RecycleUpdate(const int kc, const REAL_TYPE cs);
+  
+  
+  /**
+   * @brief 熱の陰解法の定数項と初期残差
+   * @param [in]  x     解ベクトル
+   * @param [in]  ws    対流項のみの部分段階
+   * @param [in]  qbc   境界条件の熱流束
+   * @param [in]  dth1  dt/dh
+   * @param [in]  dth2  dt/dh^2/Pe
+   * @param [out] b_l2  定数項のL2ノルム
+   * @param [out] r0_l2 初期残差ベクトルのL2ノルム
+   * @note 定数項はpcg_t, 残差はpcg_rに格納
+   */
+  void HeatResidual(REAL_TYPE* x, REAL_TYPE* ws, REAL_TYPE* qbc, REAL_TYPE dth1, REAL_TYPE dth2, double& b_l2, double& r0_l2);
+  
+  
+  /**
+   * @brief 熱の陰解法の前処理（Jacobi）
+   * @param [out] z     前処理後のベクトル
+   * @param [in]  r     ベクトル
+   * @param [in]  dth2  dt/dh^2/Pe
+   */
+  void HeatPreconditioner(REAL_TYPE* z, REAL_TYPE* r, REAL_TYPE dth2);
+  
+  
+  /**
+   * @brief 熱の陰解法の反復ベクトルの周期境界と同期
+   * @param [in,out] x  対象データ
    */
-  double Fdot2(REAL_TYPE* x, REAL_TYPE* y);
+  void SyncHeat(REAL_TYPE* x);
   
   
   /**
@@ -165,6 +324,12 @@ protected:
     // PMlib Intrinsic profiler
     TIMING__ PM->start(key);
     
+    // Event trace
+    if ( TR && TR->isEnabled() ) TR->begin(key);
+    
+    // Hardware counter
+    if ( HC && HC->isEnabled() ) HC->start(key);
+    
     const char* s_label = key.c_str();
     
     // Venus FX profiler
@@ -184,6 +349,12 @@ protected:
    */
   inline void TIMING_stop(const string key, double flopPerTask=0.0, int iterationCount=1)
   {
+    // Hardware counter
+    if ( HC && HC->isEnabled() ) HC->stop(key, flopPerTask * (double)iterationCount);
+    
+    // Event trace
+    if ( TR && TR->isEnabled() ) TR->end(key);
+    
     // Venus FX profiler
     const char* s_label = key.c_str();
     
@@ -247,6 +418,145 @@ public:
                   REAL_TYPE* cf_z);
   
   
+  /**
+   * @brief イベントトレースの設定
+   * @param [in] m_TR EventTraceクラス
+   */
+  void setEventTrace(EventTrace* m_TR)
+  {
+    TR = m_TR;
+  }
+  
+  
+  /**
+   * @brief ハードウェアカウンタの設定
+   * @param [in] m_HC HwCounterクラス
+   */
+  void setHwCounter(HwCounter* m_HC)
+  {
+    HC = m_HC;
+  }
+  
+  
+  /**
+   * @brief GMRESのワーク配列の設定
+   * @param [in] m    リスタート周期
+   * @param [in] m_v  直交基底 [size*(m+1)]
+   * @param [in] m_z  前処理後の基底 [size*m]
+   * @param [in] m_w  ワーク [size]
+   * @note Hessenberg行列などの小さな配列もここで確保し，反復毎には確保しない
+   */
+  void setGmresWork(const int m, REAL_TYPE* m_v, REAL_TYPE* m_z, REAL_TYPE* m_w)
+  {
+    gm_m = m;
+    gm_v = m_v;
+    gm_z = m_z;
+    gm_w = m_w;
+    gm_h.assign((m+1)*m, 0.0);
+    gm_cs.assign(m, 0.0);
+    gm_sn.assign(m, 0.0);
+    gm_g.assign(m+1, 0.0);
+    gm_dot.assign(m+2, 0.0);
+    gm_tmp.assign(m+2, 0.0);
+  }
+  
+  
+  /**
+   * @brief GCRO-DRの再利用部分空間の配列の設定
+   * @param [in] k    再利用部分空間の次元
+   * @param [in] m_u  基底 U [size*k]
+   * @param [in] m_c  C = A U [size*k]
+   * @note setGmresWork()の後に呼ぶ．配列の内容は時間ステップをまたいで保持する
+   */
+  void setRecycleWork(const int k, REAL_TYPE* m_u, REAL_TYPE* m_c)
+  {
+    const int n = k + gm_m;
+    
+    rc_k = k;
+    rc_n = 0;
+    rc_u = m_u;
+    rc_c = m_c;
+    rc_cs = 0.0;
+    rc_b.assign(k*gm_m, 0.0);
+    rc_h.assign((gm_m+1)*gm_m, 0.0);
+    rc_f.assign((n+1)*n, 0.0);
+    rc_g.assign((n+1)*n, 0.0);
+    rc_s.assign(n*n, 0.0);
+    rc_q.assign(n*n, 0.0);
+    rc_e.assign(n*n, 0.0);
+    gm_dot.assign(n+2, 0.0);
+    gm_tmp.assign((n+1)*n, 0.0);
+  }
+  
+  
+  /**
+   * @brief Chebyshev反復のワーク配列の設定
+   * @param [in] m_r  残差
+   * @param [in] m_d  修正量
+   * @param [in] m_q  ワーク
+   */
+  void setChebyshevWork(REAL_TYPE* m_r, REAL_TYPE* m_d, REAL_TYPE* m_q)
+  {
+    ch_r = m_r;
+    ch_d = m_d;
+    ch_q = m_q;
+    ch_lmax = 0.0;
+  }
+  
+  
+  /**
+   * @brief 色分離配置のSORのワーク配列の設定
+   * @param [in] m_p   圧力 [2*(hx+2)*(size[1]+2)*(size[2]+2)]
+   * @param [in] m_b   RHS [2*hx*size[1]*size[2]]
+   * @param [in] m_bp  BCindex P [2*hx*size[1]*size[2]]
+   * @note hx = (size[0]+1)/2
+   */
+  void setColorSplitWork(REAL_TYPE* m_p, REAL_TYPE* m_b, int* m_bp)
+  {
+    cs_hx = (size[0]+1)/2;
+    cs_p  = m_p;
+    cs_b  = m_b;
+    cs_bp = m_bp;
+    cs_packed = false;
+  }
+  
+  
+  /**
+   * @brief FFTによる直接解法の準備
+   * @note 外部境界の種類は境界セルのビットから判定する．障害物や内部境界がある場合，
+   *       ソルバーとしては使えないので終了し，前処理の場合は近似として使う
+   */
+  void setFFTPoisson();
+  
+  
+  /**
+   * @brief FFTによる直接解法
+   * @retval 反復数 (1)
+   * @param [in,out] x      解ベクトル
+   * @param [in]     b      RHS vector
+   * @param [in]     dt     時間積分幅
+   * @param [in]     b_l2   L2 norm of b vector
+   * @param [in]     r0_l2  初期残差ベクトルのL2ノルム
+   * @note 収束判定のための残差は解いた後に計算する
+   */
+  int FFTSolve(REAL_TYPE* x, REAL_TYPE* b, const REAL_TYPE dt, const double b_l2, const double r0_l2);
+  
+  
+  /**
+   * @brief Chebyshev加速Jacobi反復
+   * @retval 反復数
+   * @param [in,out] x              解ベクトル
+   * @param [in]     b              RHS vector
+   * @param [in]     dt             時間積分幅
+   * @param [in]     itrMax         反復最大値（前処理の場合は多項式の次数）
+   * @param [in]     b_l2           L2 norm of b vector
+   * @param [in]     r0_l2          初期残差ベクトルのL2ノルム
+   * @param [in]     converge_check 収束判定を行う(true)
+   * @note 反復中に内積を含まない．収束判定はgetInnerItr()回毎の残差のみ
+   */
+  int Chebyshev(REAL_TYPE* x, REAL_TYPE* b, const REAL_TYPE dt, const int itrMax, const double b_l2, const double r0_l2, bool converge_check=true);
+  
+  
   /** 
    * @brief SOR法
    * @retval 反復数
@@ -304,6 +614,21 @@ public:
   int RC_sor(REAL_TYPE* x, REAL_TYPE* pos_rhs, REAL_TYPE* b, int* bcp, const double r0_l2);
   
   
+  /**
+   * @brief ゼブラ順序のラインSOR法
+   * @retval 反復数
+   * @param [in,out] x              解ベクトル
+   * @param [in]     b              RHS vector
+   * @param [in]     dt             時間積分幅
+   * @param [in]     itrMax         反復最大値
+   * @param [in]     b_l2           L2 norm of b vector
+   * @param [in]     r0_l2          初期残差ベクトルのL2ノルム
+   * @param [in]     converge_check 収束判定を行う(true)
+   * @note 格子幅の異方性が大きい場合に，結合の強い方向のラインを三重対角行列で解く
+   */
+  int LineSOR(REAL_TYPE* x, REAL_TYPE* b, const REAL_TYPE dt, const int itrMax, const double b_l2, const double r0_l2, bool converge_check=true);
+  
+  
   /**
    * @brief 2色オーダリングSORのストライドメモリアクセス版
    * @retval 反復数
@@ -317,6 +642,22 @@ public:
    */
   int SOR2_SMA(REAL_TYPE* x, REAL_TYPE* b, const REAL_TYPE dt, const int itrMax, const double b_l2, const double r0_l2, bool converge_check=true);
   
+  
+  /**
+   * @brief 2色オーダリングSORの色分離配置版
+   * @retval 反復数
+   * @param [in,out] x              解ベクトル
+   * @param [in]     b              RHS vector
+   * @param [in]     dt             時間積分幅
+   * @param [in]     itrMax         反復最大値
+   * @param [in]     b_l2           L2 norm of b vector
+   * @param [in]     r0_l2          初期残差ベクトルのL2ノルム
+   * @param [in]     converge_check 収束判定を行う(true)
+   * @note 求解の開始時に圧力とRHSを色毎の連続配列に詰め，反復はその上で行い，終了時にxに戻す．
+   *       色毎の袖の同期は面に接するセルだけをxに書き戻して行う
+   */
+  int SOR2_CS(REAL_TYPE* x, REAL_TYPE* b, const REAL_TYPE dt, const int itrMax, const double b_l2, const double r0_l2, bool converge_check=true);
+  
 
   /**
    * @brief 前処理つきBiCGstab
@@ -330,6 +671,44 @@ public:
   int PBiCGstab(REAL_TYPE* x, REAL_TYPE* b, const REAL_TYPE dt, const double b_l2, const double r0_l2);
   
   
+  /**
+   * @brief 前処理つきFlexible GMRES(m)
+   * @retval 反復数
+   * @param [in,out] x       解ベクトル
+   * @param [in]     b       RHS vector
+   * @param [in]     dt      時間積分幅
+   * @param [in]     b_l2    L2 norm of b vector
+   * @param [in]     r0_l2   初期残差ベクトルのL2ノルム
+   * @note 直交化は再直交化つき古典Gram-Schmidt(CGS2)．Arnoldi 1ステップあたりの集約は
+   *       基底数によらず2回．再利用部分空間がある場合はGCRO-DRとして，Cに直交な空間でArnoldiを行う
+   */
+  int FGMRES(REAL_TYPE* x, REAL_TYPE* b, const REAL_TYPE dt, const double b_l2, const double r0_l2);
+  
+  
+  /**
+   * @brief 単媒質の熱伝導方程式（陰解法）の前処理つきCG
+   * @retval 反復数
+   * @param [in,out] x    解ベクトル
+   * @param [in]     ws   対流項のみの部分段階
+   * @param [in]     qbc  境界条件の熱流束
+   * @param [in]     dt   時間積分幅
+   * @note 係数行列はps_Diff_SM_PSOR()と同じ離散化，前処理はJacobi
+   */
+  int PCG_Heat(REAL_TYPE* x, REAL_TYPE* ws, REAL_TYPE* qbc, const REAL_TYPE dt);
+  
+  
+  /**
+   * @brief 単媒質の熱伝導方程式（陰解法）の前処理つきBiCGstab
+   * @retval 反復数
+   * @param [in,out] x    解ベクトル
+   * @param [in]     ws   対流項のみの部分段階
+   * @param [in]     qbc  境界条件の熱流束
+   * @param [in]     dt   時間積分幅
+   * @note 係数行列はps_Diff_SM_PSOR()と同じ離散化，前処理はJacobi
+   */
+  int PBiCGstab_Heat(REAL_TYPE* x, REAL_TYPE* ws, REAL_TYPE* qbc, const REAL_TYPE dt);
+  
+  
   /**
    * @brief  FPCG
    * @retval 反復数
@@ -0,0 +1,226 @@
+#ifndef _FFV_DELTA_CHECKPOINT_H_
+#define _FFV_DELTA_CHECKPOINT_H_
+
+//##################################################################################
+//
+// FFV-C : Frontflow / violet Cartesian
+//
+// Copyright (c) 2007-2011 VCAD System Research Program, RIKEN.
+// All rights reserved.
+//
+// Copyright (c) 2011-2015 Institute of Industrial Science, The University of Tokyo.
+// All rights reserved.
+//
+// Copyright (c) 2012-2015 Advanced Institute for Computational Science, RIKEN.
+// All rights reserved.
+//
+//##################################################################################
+//
+
+/**
+ * @file   DeltaCheckpoint.h
+ * @brief  差分チェックポイント（ブロックハッシュとマニフェスト）
+ * @author aics
+ * @note   各ランクは配列をブロックに分割し，前回のチェックポイントからハッシュが
+ *         変化したブロックだけをデータファイルに追記する．マニフェストは全ブロックについて
+ *         最新の内容を保持するデータファイルとオフセットを記録するので，読み込みは
+ *         マニフェスト1つからチェーンを辿らずに復元できる
+ */
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "FB_Define.h"
+
+using namespace std;
+
+
+class DeltaCheckpoint {
+
+public:
+  /// フィールドのグループ
+  enum ckpt_group
+  {
+    ckpt_instantaneous=0,
+    ckpt_statistic
+  };
+
+private:
+
+  /// 登録フィールド
+  struct Field
+  {
+    string name;                 ///< 名前（マニフェストとの照合に利用）
+    REAL_TYPE* ptr;              ///< 配列
+    size_t nelem;                ///< 要素数
+    int group;                   ///< グループ
+    vector<unsigned long long> hash; ///< 前回のチェックポイントでのブロックハッシュ
+    vector<unsigned> file;       ///< ブロックを保持するデータファイルのステップ
+    vector<unsigned long long> offset; ///< データファイル内のオフセット
+  };
+
+  vector<Field> fld;       ///< 登録フィールド
+  size_t blockElem;        ///< 1ブロックの要素数
+  int fullInterval;        ///< 全ブロックを書き出す間隔（チェックポイント数）
+  int count;               ///< このセッションで書き出したチェックポイント数
+
+  size_t statWritten;      ///< 直前のチェックポイントで書いたブロック数
+  size_t statTotal;        ///< 直前のチェックポイントの全ブロック数
+
+
+public:
+
+  /** コンストラクタ */
+  DeltaCheckpoint() {
+    blockElem    = 65536;
+    fullInterval = 0;
+    count        = 0;
+    statWritten  = 0;
+    statTotal    = 0;
+  }
+
+  /** デストラクタ */
+  ~DeltaCheckpoint() {}
+
+
+  /**
+   * @brief パラメータの設定
+   * @param [in] m_blockElem    1ブロックの要素数
+   * @param [in] m_fullInterval 全ブロックを書き出す間隔（0の場合はセッション最初のみ）
+   */
+  void setParameter(const size_t m_blockElem, const int m_fullInterval)
+  {
+    blockElem    = (m_blockElem > 0) ? m_blockElem : 65536;
+    fullInterval = m_fullInterval;
+  }
+
+
+  /** @brief 1ブロックの要素数 */
+  size_t getBlockElem() const
+  {
+    return blockElem;
+  }
+
+
+  /** @brief 全ブロックを書き出す間隔 */
+  int getFullInterval() const
+  {
+    return fullInterval;
+  }
+
+
+  /** @brief フィールドが登録されているか */
+  bool hasFields() const
+  {
+    return !fld.empty();
+  }
+
+
+  /**
+   * @brief 直前のチェックポイントの書き出しブロック数
+   * @param [out] written 書き出したブロック数
+   * @param [out] total   全ブロック数
+   */
+  void getLastStat(size_t& written, size_t& total) const
+  {
+    written = statWritten;
+    total   = statTotal;
+  }
+
+
+  /**
+   * @brief フィールドを登録
+   * @param [in] name  名前
+   * @param [in] ptr   配列
+   * @param [in] nelem 要素数
+   * @param [in] group グループ
+   */
+  void addField(const string& name, REAL_TYPE* ptr, const size_t nelem, const int group);
+
+
+  /**
+   * @brief チェックポイントの書き出し
+   * @param [in] dir       出力ディレクトリ
+   * @param [in] rank      ランク番号
+   * @param [in] nproc     プロセス数
+   * @param [in] step      ステップ
+   * @param [in] time      時刻
+   * @param [in] step_stat 統計の積算ステップ数
+   * @param [in] time_stat 統計の積算時間
+   * @retval 成功した場合true
+   */
+  bool write(const string& dir,
+             const int rank,
+             const int nproc,
+             const unsigned step,
+             const double time,
+             const unsigned step_stat,
+             const double time_stat);
+
+
+  /**
+   * @brief マニフェストが存在するか
+   * @param [in] dir  入力ディレクトリ
+   * @param [in] rank ランク番号
+   * @param [in] step ステップ
+   */
+  static bool exist(const string& dir, const int rank, const unsigned step);
+
+
+  /**
+   * @brief マニフェストに記録された書き出し時のプロセス数
+   * @param [in] dir  入力ディレクトリ
+   * @param [in] rank ランク番号
+   * @param [in] step ステップ
+   * @retval プロセス数，マニフェストが読めない場合は-1
+   */
+  static int getNumProc(const string& dir, const int rank, const unsigned step);
+
+
+  /**
+   * @brief チェックポイントからグループのフィールドを復元
+   * @param [in]  dir       入力ディレクトリ
+   * @param [in]  rank      ランク番号
+   * @param [in]  step      ステップ
+   * @param [in]  group     復元するグループ
+   * @param [out] time      時刻
+   * @param [out] step_stat 統計の積算ステップ数
+   * @param [out] time_stat 統計の積算時間
+   * @retval 成功した場合true
+   * @note 読み込んだブロックはマニフェストのハッシュと照合する
+   */
+  bool read(const string& dir,
+            const int rank,
+            const unsigned step,
+            const int group,
+            double& time,
+            unsigned& step_stat,
+            double& time_stat);
+
+
+private:
+
+  /**
+   * @brief ブロックのハッシュ
+   * @param [in] p     先頭
+   * @param [in] bytes バイト数
+   */
+  static unsigned long long hashBlock(const unsigned char* p, const size_t bytes);
+
+
+  /** @brief マニフェストのファイル名 */
+  static string manifestName(const string& dir, const int rank, const unsigned step);
+
+
+  /** @brief データファイル名 */
+  static string dataName(const string& dir, const int rank, const unsigned step);
+
+
+  /** @brief フィールドのブロック数 */
+  size_t numBlocks(const Field& f) const
+  {
+    return (f.nelem + blockElem - 1) / blockElem;
+  }
+};
+
+#endif // _FFV_DELTA_CHECKPOINT_H_
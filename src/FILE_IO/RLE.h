@@ -144,6 +144,174 @@ namespace BVX_IO {
 		return dest;
 	}
 
+
+	
+	/// 並列版RLEの1チャンクあたりの入力要素数
+	const size_t RLE_CHUNK_ELEMENTS = 1 << 18;
+	
+	
+#ifdef __GNUC__
+#pragma pack(push, 1)
+#define ALIGNMENT __attribute__((packed))
+#else
+#pragma pack(1)
+#define ALIGNMENT
+#endif // __GNUC__
+	/// RLE符号の走査用構造体 (rleEncode/rleDecodeと同一のレイアウト)
+	template <typename rluint_t, typename runlen_t>
+	struct RleCode {
+		rluint_t d;
+		runlen_t len;
+	} ALIGNMENT;
+#ifdef __GNUC__
+#pragma pack(pop)
+#else  // __GNUC__
+#pragma pack()
+#endif // __GNUC__
+	
+	
+	/// 値vのランの終端を探す
+	///
+	/// @param[in] p 入力データ
+	/// @param[in] i 探索開始位置
+	/// @param[in] e 探索終了位置 (この位置は含まない)
+	/// @param[in] v ランの値
+	/// @return    p[i]!=vとなる最初の位置．見つからない場合e
+	///
+	/// @note 固定幅のブロック比較はSIMD化される
+	///
+	template <typename rluint_t>
+	inline size_t rleRunEnd(const rluint_t* p, size_t i, const size_t e, const rluint_t v)
+	{
+		const size_t W = 16;
+		
+		while( i + W <= e ){
+			unsigned diff = 0;
+			for(size_t l = 0; l < W; l++){
+				diff |= (p[i+l] != v);
+			}
+			if( diff ) break;
+			i += W;
+		}
+		
+		while( i < e && p[i] == v ) i++;
+		
+		return i;
+	}
+	
+	
+	/// チャンクの開始位置をランの先頭に合わせる
+	///
+	/// @param[in] p 入力データ
+	/// @param[in] i 公称の開始位置
+	/// @param[in] e 公称の終了位置
+	/// @return    [i, e)内で最初にランが始まる位置 (p[i-1]!=p[i]となる位置)．無い場合e
+	///
+	template <typename rluint_t>
+	inline size_t rleChunkHead(const rluint_t* p, const size_t i, const size_t e)
+	{
+		if( i == 0 ) return 0;
+		return rleRunEnd<rluint_t>(p, i, e, p[i-1]);
+	}
+	
+	
+	/// RLE圧縮 (OpenMPによるチャンク並列版)
+	///
+	/// @param[in]  source     入力データの先頭ポインタ
+	/// @param[in]  sourceSize 入力データのサイズ (Byte単位で指定)
+	/// @param[out] destSize   出力データのサイズ (Byte単位で指定)
+	/// @return     RLE圧縮符号の先頭ポインタ．エラーの場合NULLを返す
+	///
+	/// @note 出力はrleEncode()とバイト単位で一致する．チャンク境界をランの先頭に
+	///       合わせ，1パス目で各チャンクの符号数を数え，2パス目で確定した位置に
+	///       直接書き込むため，最悪ケースサイズの作業領域は確保しない
+	/// @note returnされたポインタは適宜解放(delete)してください．
+	///
+	template <typename rluint_t, typename runlen_t>
+	unsigned char* rleEncodeParallel(const rluint_t* source, const size_t sourceSize, size_t* destSize)
+	{
+		typedef RleCode<rluint_t, runlen_t> DR;
+		
+		const size_t maxCount = (size_t)((runlen_t)~0);
+		const size_t n        = sourceSize / sizeof(rluint_t);
+		
+		*destSize = 0;
+		if( !source || n == 0 ) return NULL;
+		
+		const size_t nc = (n + RLE_CHUNK_ELEMENTS - 1) / RLE_CHUNK_ELEMENTS;
+		
+		// チャンク境界 head[c]..head[c+1]
+		size_t* head = new size_t[nc+1];
+		size_t* ofs  = new size_t[nc+1];
+		
+		#pragma omp parallel for schedule(static)
+		for(long c = 0; c < (long)nc; c++){
+			const size_t s = (size_t)c * RLE_CHUNK_ELEMENTS;
+			const size_t e = (s + RLE_CHUNK_ELEMENTS < n) ? s + RLE_CHUNK_ELEMENTS : n;
+			head[c] = rleChunkHead<rluint_t>(source, s, e);
+		}
+		head[nc] = n;
+		
+		// ランの先頭を含まないチャンクは空にし，前のチャンクが続きを受け持つ
+		for(size_t c = nc-1; c > 0; c--){
+			const size_t e = (c+1) * RLE_CHUNK_ELEMENTS < n ? (c+1) * RLE_CHUNK_ELEMENTS : n;
+			if( head[c] == e ) head[c] = head[c+1];
+		}
+		
+		// 1パス目 : 符号数
+		#pragma omp parallel for schedule(dynamic, 1)
+		for(long c = 0; c < (long)nc; c++){
+			size_t cnt = 0;
+			size_t i   = head[c];
+			const size_t e = head[c+1];
+			
+			while( i < e ){
+				size_t r = rleRunEnd<rluint_t>(source, i+1, e, source[i]);
+				cnt += (r - i + maxCount - 1) / maxCount;
+				i = r;
+			}
+			ofs[c+1] = cnt;
+		}
+		
+		ofs[0] = 0;
+		for(size_t c = 0; c < nc; c++) ofs[c+1] += ofs[c];
+		
+		const size_t numCode = ofs[nc];
+		unsigned char* dest  = new unsigned char[numCode * sizeof(DR)];
+		DR* pdr = reinterpret_cast<DR*>(dest);
+		
+		// 2パス目 : 書き込み
+		#pragma omp parallel for schedule(dynamic, 1)
+		for(long c = 0; c < (long)nc; c++){
+			DR* q = pdr + ofs[c];
+			size_t i = head[c];
+			const size_t e = head[c+1];
+			
+			while( i < e ){
+				const rluint_t d = source[i];
+				size_t r = rleRunEnd<rluint_t>(source, i+1, e, d);
+				size_t len = r - i;
+				
+				while( len > 0 ){
+					size_t l = len < maxCount ? len : maxCount;
+					q->d   = d;
+					q->len = (runlen_t)l;
+					q++;
+					len -= l;
+				}
+				i = r;
+			}
+		}
+		
+		delete [] head;
+		delete [] ofs;
+		
+		*destSize = numCode * sizeof(DR);
+		
+		return dest;
+	}
+	
+	
 } // BVX_IO
 
 #endif // __FFV_RLE_H__
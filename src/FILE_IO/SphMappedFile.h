@@ -0,0 +1,482 @@
+#ifndef _FFV_SPH_MAPPED_FILE_H_
+#define _FFV_SPH_MAPPED_FILE_H_
+
+//##################################################################################
+//
+// FFV-C : Frontflow / violet Cartesian
+//
+// Copyright (c) 2007-2011 VCAD System Research Program, RIKEN.
+// All rights reserved.
+//
+// Copyright (c) 2011-2015 Institute of Industrial Science, The University of Tokyo.
+// All rights reserved.
+//
+// Copyright (c) 2012-2015 Advanced Institute for Computational Science, RIKEN.
+// All rights reserved.
+//
+//##################################################################################
+
+/**
+ * @file   SphMappedFile.h
+ * @brief  SPHファイルのメモリマップ読み込みクラス
+ * @note   ファイル全体をmmap()し，ヘッダレコードを解釈した後，データレコードを
+ *         バッファへコピーせずにそのまま参照する．エンディアン変換と型変換は
+ *         転送先配列への1回のコピーの中で同時に行う
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+class SphMappedFile {
+
+public:
+  /// データ種別 (SPH仕様)
+  enum sph_data_type {
+    sph_scalar=1,
+    sph_vector
+  };
+
+  /// 実数型 (SPH仕様)
+  enum sph_real_type {
+    sph_float=1,
+    sph_double
+  };
+
+private:
+  unsigned char* base; ///< マップ領域の先頭
+  size_t length;       ///< ファイル長 [byte]
+  bool swap;           ///< エンディアン変換が必要な場合true
+  int dType;           ///< データ種別
+  int rType;           ///< 実数型
+  int nVar;            ///< 成分数
+  long long voxsize[3];///< ヘッダに記述された配列サイズ（ガイドセルを含む）
+  double org[3];       ///< 原点座標
+  double pit[3];       ///< 格子幅
+  long long step;      ///< ステップ
+  double time;         ///< 時刻
+  const unsigned char* record; ///< データレコードの先頭
+  size_t rec_bytes;    ///< データレコードのサイズ [byte]
+
+
+public:
+  /** コンストラクタ */
+  SphMappedFile() {
+    base = NULL;
+    length = 0;
+    clear();
+  }
+
+  /** デストラクタ */
+  ~SphMappedFile() {
+    close();
+  }
+
+
+private:
+
+  /** ヘッダ情報のクリア */
+  void clear()
+  {
+    swap = false;
+    dType = 0;
+    rType = 0;
+    nVar  = 0;
+    step  = 0;
+    time  = 0.0;
+    record = NULL;
+    rec_bytes = 0;
+    for (int i=0; i<3; i++)
+    {
+      voxsize[i] = 0;
+      org[i] = 0.0;
+      pit[i] = 0.0;
+    }
+  }
+
+
+  /**
+   * @brief 4byte整数の取り出し
+   * @param [in,out] pos 読み込み位置，読み込み後に進める
+   * @param [out]    v   値
+   */
+  bool get32(size_t& pos, uint32_t& v) const
+  {
+    if ( pos + 4 > length ) return false;
+    memcpy(&v, base+pos, 4);
+    if ( swap ) v = bswap32(v);
+    pos += 4;
+    return true;
+  }
+
+
+  /**
+   * @brief 8byte整数の取り出し
+   * @param [in,out] pos 読み込み位置，読み込み後に進める
+   * @param [out]    v   値
+   */
+  bool get64(size_t& pos, uint64_t& v) const
+  {
+    if ( pos + 8 > length ) return false;
+    memcpy(&v, base+pos, 8);
+    if ( swap ) v = bswap64(v);
+    pos += 8;
+    return true;
+  }
+
+
+  /**
+   * @brief 実数の取り出し（rTypeに応じて4/8byte）
+   * @param [in,out] pos 読み込み位置
+   * @param [out]    v   値
+   */
+  bool getReal(size_t& pos, double& v) const
+  {
+    if ( rType == sph_float )
+    {
+      uint32_t u;
+      float f;
+      if ( !get32(pos, u) ) return false;
+      memcpy(&f, &u, 4);
+      v = (double)f;
+    }
+    else
+    {
+      uint64_t u;
+      if ( !get64(pos, u) ) return false;
+      memcpy(&v, &u, 8);
+    }
+    return true;
+  }
+
+
+  /**
+   * @brief 整数の取り出し（rTypeに応じて4/8byte）
+   * @param [in,out] pos 読み込み位置
+   * @param [out]    v   値
+   */
+  bool getInt(size_t& pos, long long& v) const
+  {
+    if ( rType == sph_float )
+    {
+      uint32_t u;
+      if ( !get32(pos, u) ) return false;
+      v = (long long)(int32_t)u;
+    }
+    else
+    {
+      uint64_t u;
+      if ( !get64(pos, u) ) return false;
+      v = (long long)u;
+    }
+    return true;
+  }
+
+
+  /**
+   * @brief Fortranレコードマーカーの照合
+   * @param [in,out] pos    読み込み位置
+   * @param [in]     expect 期待値 [byte]
+   */
+  bool marker(size_t& pos, const uint32_t expect) const
+  {
+    uint32_t m;
+    if ( !get32(pos, m) ) return false;
+    return ( m == expect );
+  }
+
+
+  static inline uint32_t bswap32(const uint32_t x)
+  {
+    return ( ((x & 0xff000000u) >> 24) | ((x & 0x00ff0000u) >>  8) |
+             ((x & 0x0000ff00u) <<  8) | ((x & 0x000000ffu) << 24) );
+  }
+
+  static inline uint64_t bswap64(const uint64_t x)
+  {
+    return ( ((uint64_t)bswap32((uint32_t)(x & 0xffffffffull)) << 32) |
+              (uint64_t)bswap32((uint32_t)(x >> 32)) );
+  }
+
+
+  /**
+   * @brief 1行分の変換コピー
+   * @param [out] d  転送先
+   * @param [in]  s  データレコード中の転送元
+   * @param [in]  n  要素数
+   * @param [in]  sw エンディアン変換フラグ
+   * @note 型変換とエンディアン変換を同じループで行う
+   */
+  template <typename S, typename T>
+  static inline void convertRow(T* d, const unsigned char* s, const size_t n, const bool sw)
+  {
+    const size_t w = sizeof(S);
+
+    if ( !sw )
+    {
+      for (size_t m=0; m<n; m++)
+      {
+        S v;
+        memcpy(&v, s+m*w, w);
+        d[m] = (T)v;
+      }
+    }
+    else
+    {
+      for (size_t m=0; m<n; m++)
+      {
+        unsigned char b[sizeof(S)];
+        const unsigned char* p = s+m*w;
+        for (size_t l=0; l<w; l++) b[l] = p[w-1-l];
+        S v;
+        memcpy(&v, b, w);
+        d[m] = (T)v;
+      }
+    }
+  }
+
+
+public:
+
+  /**
+   * @brief ファイルをマップし，ヘッダレコードを解釈する
+   * @param [in] fname ファイル名
+   * @retval true=success, false=fault
+   */
+  bool open(const char* fname)
+  {
+    close();
+
+    if ( !fname ) return false;
+
+    int fd = ::open(fname, O_RDONLY);
+    if ( fd < 0 )
+    {
+      fprintf(stderr, "Can't open file.(%s)\n", fname);
+      return false;
+    }
+
+    struct stat st;
+    if ( fstat(fd, &st) != 0 || st.st_size < 4 )
+    {
+      ::close(fd);
+      return false;
+    }
+
+    length = (size_t)st.st_size;
+    void* p = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // マップはfdを閉じても有効
+
+    if ( p == MAP_FAILED )
+    {
+      length = 0;
+      return false;
+    }
+    base = (unsigned char*)p;
+
+    // 先頭のレコードマーカー(8)でエンディアンを判定
+    uint32_t m0;
+    memcpy(&m0, base, 4);
+    if      ( m0 == 8 )          swap = false;
+    else if ( bswap32(m0) == 8 ) swap = true;
+    else { close(); return false; }
+
+    if ( !parseHeader() ) { close(); return false; }
+
+    // データレコードは先頭から順に一度だけ触るので先読みを指示
+    madvise(base, length, MADV_SEQUENTIAL);
+    madvise(base, length, MADV_WILLNEED);
+
+    return true;
+  }
+
+
+  /** @brief マップの解放 */
+  void close()
+  {
+    if ( base ) munmap(base, length);
+    base = NULL;
+    length = 0;
+    clear();
+  }
+
+
+  /**
+   * @brief ヘッダレコードの解釈とデータレコードの位置決定
+   * @retval true=success, false=fault
+   */
+  bool parseHeader()
+  {
+    size_t pos = 0;
+    uint32_t u;
+
+    // data type, real type
+    if ( !marker(pos, 8) ) return false;
+    if ( !get32(pos, u) ) return false;
+    dType = (int)u;
+    if ( !get32(pos, u) ) return false;
+    rType = (int)u;
+    if ( !marker(pos, 8) ) return false;
+
+    if      ( dType == sph_scalar ) nVar = 1;
+    else if ( dType == sph_vector ) nVar = 3;
+    else return false;
+
+    if ( rType != sph_float && rType != sph_double ) return false;
+
+    const uint32_t w  = ( rType == sph_float ) ? 4 : 8;
+    const uint32_t r3 = 3*w;
+
+    // size
+    if ( !marker(pos, r3) ) return false;
+    for (int i=0; i<3; i++) if ( !getInt(pos, voxsize[i]) ) return false;
+    if ( !marker(pos, r3) ) return false;
+
+    // origin
+    if ( !marker(pos, r3) ) return false;
+    for (int i=0; i<3; i++) if ( !getReal(pos, org[i]) ) return false;
+    if ( !marker(pos, r3) ) return false;
+
+    // pitch
+    if ( !marker(pos, r3) ) return false;
+    for (int i=0; i<3; i++) if ( !getReal(pos, pit[i]) ) return false;
+    if ( !marker(pos, r3) ) return false;
+
+    // step, time
+    if ( !marker(pos, 2*w) ) return false;
+    if ( !getInt(pos, step) ) return false;
+    if ( !getReal(pos, time) ) return false;
+    if ( !marker(pos, 2*w) ) return false;
+
+    // data
+    if ( voxsize[0] < 1 || voxsize[1] < 1 || voxsize[2] < 1 ) return false;
+
+    rec_bytes = (size_t)voxsize[0] * (size_t)voxsize[1] * (size_t)voxsize[2] * (size_t)nVar * (size_t)w;
+
+    // 4GBを超えるレコードのマーカーは下位32bitのみが記録される
+    if ( !marker(pos, (uint32_t)rec_bytes) ) return false;
+    if ( pos + rec_bytes + 4 > length ) return false;
+
+    record = base + pos;
+    pos += rec_bytes;
+
+    if ( !marker(pos, (uint32_t)rec_bytes) ) return false;
+
+    return true;
+  }
+
+
+  /** @brief マップされているかどうか */
+  bool isOpen() const { return ( base != NULL ); }
+
+  /** @brief エンディアン変換が必要かどうか */
+  bool isSwapped() const { return swap; }
+
+  /** @brief データ種別 */
+  int getDataType() const { return dType; }
+
+  /** @brief 実数型 */
+  int getRealType() const { return rType; }
+
+  /** @brief 成分数 */
+  int getNumVariables() const { return nVar; }
+
+  /** @brief 配列サイズ（ガイドセルを含む） */
+  const long long* getSize() const { return voxsize; }
+
+  /** @brief 原点座標 */
+  const double* getOrigin() const { return org; }
+
+  /** @brief 格子幅 */
+  const double* getPitch() const { return pit; }
+
+  /** @brief ステップ */
+  long long getStep() const { return step; }
+
+  /** @brief 時刻 */
+  double getTime() const { return time; }
+
+  /**
+   * @brief データレコードのビュー
+   * @note  ファイル上のバイト列をそのまま指す．isSwapped()がtrueの場合は変換が必要
+   */
+  const void* getRecord() const { return record; }
+
+  /** @brief データレコードのサイズ [byte] */
+  size_t getRecordSize() const { return rec_bytes; }
+
+
+  /**
+   * @brief データレコードを転送先配列へ変換コピーする
+   * @param [out] dst    転送先配列（成分が最内のNIJK配置）
+   * @param [in]  sz     内部セル数
+   * @param [in]  dst_gc 転送先配列のガイドセル幅
+   * @param [in]  src_gc ファイルのガイドセル幅
+   * @param [in]  gc_cp  コピーするガイドセル幅（0のとき内部セルのみ）
+   * @retval true=success, false=fault
+   * @note エンディアン変換，実数型の変換，ガイドセル幅の調整を1パスで行う．
+   *       コピー範囲外の転送先の値は変更しない
+   */
+  template <typename T>
+  bool copyTo(T* dst, const int* sz, const int dst_gc, const int src_gc, const int gc_cp) const
+  {
+    if ( !base || !dst || !sz ) return false;
+
+    for (int i=0; i<3; i++)
+    {
+      if ( voxsize[i] != (long long)(sz[i] + 2*src_gc) ) return false;
+    }
+
+    int g = gc_cp;
+    if ( g > src_gc ) g = src_gc;
+    if ( g > dst_gc ) g = dst_gc;
+    if ( g < 0 ) g = 0;
+
+    const size_t nv = (size_t)nVar;
+    const size_t sx = (size_t)voxsize[0];
+    const size_t sy = (size_t)voxsize[1];
+    const size_t dx = (size_t)(sz[0] + 2*dst_gc);
+    const size_t dy = (size_t)(sz[1] + 2*dst_gc);
+    const size_t w  = ( rType == sph_float ) ? 4 : 8;
+    const size_t n  = (size_t)(sz[0] + 2*g) * nv;
+    const int js = -g;
+    const int je = sz[1] + g;
+    const int ks = -g;
+    const int ke = sz[2] + g;
+    const int so = src_gc - g;
+    const int dof = dst_gc - g;
+    const int sg = src_gc;
+    const int dg = dst_gc;
+    const bool sw = swap;
+    const int rt = rType;
+    const unsigned char* src = record;
+
+#pragma omp parallel for firstprivate(js, je, ks, ke, so, dof, sg, dg, sx, sy, dx, dy, w, n, nv, sw, rt) schedule(static)
+    for (int k=ks; k<ke; k++) {
+      for (int j=js; j<je; j++) {
+        size_t ms = ( ((size_t)(k+sg) * sy + (size_t)(j+sg)) * sx + (size_t)so  ) * nv;
+        size_t md = ( ((size_t)(k+dg) * dy + (size_t)(j+dg)) * dx + (size_t)dof ) * nv;
+
+        if ( rt == sph_float )
+        {
+          convertRow<float, T>(dst+md, src+ms*w, n, sw);
+        }
+        else
+        {
+          convertRow<double, T>(dst+md, src+ms*w, n, sw);
+        }
+      }
+    }
+
+    return true;
+  }
+
+};
+
+#endif // _FFV_SPH_MAPPED_FILE_H_
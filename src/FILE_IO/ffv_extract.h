@@ -0,0 +1,200 @@
+#ifndef _FFV_EXTRACT_H_
+#define _FFV_EXTRACT_H_
+
+//##################################################################################
+//
+// FFV-C : Frontflow / violet Cartesian
+//
+// Copyright (c) 2007-2011 VCAD System Research Program, RIKEN.
+// All rights reserved.
+//
+// Copyright (c) 2011-2015 Institute of Industrial Science, The University of Tokyo.
+// All rights reserved.
+//
+// Copyright (c) 2012-2015 Advanced Institute for Computational Science, RIKEN.
+// All rights reserved.
+//
+//##################################################################################
+//
+
+/**
+ * @file   ffv_extract.h
+ * @brief  In-situ抽出出力（断面・部分領域・間引き）の定義
+ * @author aics
+ */
+
+#include <string>
+#include <vector>
+#include "IntervalManager.h"
+
+using namespace std;
+
+
+/**
+ * @brief 抽出出力の1項目
+ * @note  抽出範囲はグローバルなセルインデクス(1始まり)で与え，strideで間引く．
+ *        断面は抽出方向のインデクス幅が1の部分領域として扱う
+ */
+class ExtractItem {
+
+public:
+  /// 抽出形状
+  enum extract_type
+  {
+    ext_slice=1,
+    ext_box
+  };
+
+  /// 抽出変数
+  enum extract_var
+  {
+    ext_pressure=0,
+    ext_velocity,
+    ext_temperature,
+    ext_vorticity,
+    ext_var_END
+  };
+
+  string label;            ///< ラベル（出力ファイル名のプレフィックス）
+  int type;                ///< 抽出形状
+  int var[ext_var_END];    ///< 抽出変数のON/OFF
+  int st[3];               ///< 抽出範囲の始点（グローバルインデクス）
+  int ed[3];               ///< 抽出範囲の終点（グローバルインデクス）
+  int stride[3];           ///< 間引き間隔
+  int gsz[3];              ///< 抽出後の全体サイズ
+  int lst[3];              ///< 自ランクが担当する最初の抽出点番号 (0始まり)
+  int lsz[3];              ///< 自ランクが担当する抽出点数
+  IntervalManager Intvl;   ///< 出力タイミング
+  vector<int> rbox;        ///< 各ランクのlst, lsz (マスターランクのみ保持)
+  int grid_out;            ///< 格子ファイルを書き出し済みの場合1 (マスターランクのみ)
+
+
+  /** コンストラクタ */
+  ExtractItem() {
+    type = 0;
+    grid_out = 0;
+    for (int i=0; i<ext_var_END; i++) var[i] = 0;
+    for (int i=0; i<3; i++)
+    {
+      st[i]  = 0;
+      ed[i]  = 0;
+      stride[i] = 1;
+      gsz[i] = 0;
+      lst[i] = 0;
+      lsz[i] = 0;
+    }
+  }
+
+
+  /**
+   * @brief 抽出後の全体サイズを計算
+   * @retval 範囲が正しい場合true
+   */
+  bool setGlobalRange()
+  {
+    for (int i=0; i<3; i++)
+    {
+      if ( stride[i] < 1 || st[i] > ed[i] ) return false;
+      gsz[i] = (ed[i] - st[i]) / stride[i] + 1;
+    }
+    return true;
+  }
+
+
+  /**
+   * @brief 自ランクの担当範囲を計算
+   * @param [in] head 自領域の開始インデクス（グローバル, 1始まり）
+   * @param [in] size 自領域のサイズ
+   */
+  void setLocalRange(const int* head, const int* size)
+  {
+    for (int i=0; i<3; i++)
+    {
+      int lo = ( head[i] > st[i] ) ? head[i] : st[i];
+      int hi = ( head[i]+size[i]-1 < ed[i] ) ? head[i]+size[i]-1 : ed[i];
+
+      if ( lo > hi )
+      {
+        lst[i] = 0;
+        lsz[i] = 0;
+        continue;
+      }
+
+      int n_lo = ( lo - st[i] + stride[i] - 1 ) / stride[i];
+      int n_hi = ( hi - st[i] ) / stride[i];
+
+      lst[i] = n_lo;
+      lsz[i] = ( n_hi >= n_lo ) ? n_hi - n_lo + 1 : 0;
+    }
+  }
+
+
+  /** @brief 自ランクの抽出点数 */
+  size_t getLocalPoints() const
+  {
+    return (size_t)lsz[0] * (size_t)lsz[1] * (size_t)lsz[2];
+  }
+
+
+  /** @brief 全体の抽出点数 */
+  size_t getGlobalPoints() const
+  {
+    return (size_t)gsz[0] * (size_t)gsz[1] * (size_t)gsz[2];
+  }
+
+
+  /** @brief 変数の成分数 */
+  static int getNumComponents(const int v)
+  {
+    return ( v == ext_velocity || v == ext_vorticity ) ? 3 : 1;
+  }
+
+
+  /** @brief 抽出する全変数の成分数の和 */
+  int getTotalComponents() const
+  {
+    int nc = 0;
+    for (int v=0; v<ext_var_END; v++)
+    {
+      if ( var[v] ) nc += getNumComponents(v);
+    }
+    return nc;
+  }
+
+
+  /**
+   * @brief 成分名（関数名ファイルに利用）
+   * @param [in] v 抽出変数
+   * @param [in] c 成分番号
+   */
+  static const char* getComponentName(const int v, const int c)
+  {
+    static const char* vel[3] = {"Velocity_U",  "Velocity_V",  "Velocity_W"};
+    static const char* vrt[3] = {"Vorticity_X", "Vorticity_Y", "Vorticity_Z"};
+
+    switch (v)
+    {
+      case ext_pressure:    return "Pressure";
+      case ext_velocity:    return vel[c];
+      case ext_temperature: return "Temperature";
+      case ext_vorticity:   return vrt[c];
+      default:              return "unknown";
+    }
+  }
+
+
+  /** @brief 変数名（表示に利用） */
+  static const char* getVarName(const int v)
+  {
+    switch (v)
+    {
+      case ext_pressure:    return "prs";
+      case ext_velocity:    return "vel";
+      case ext_temperature: return "tmp";
+      case ext_vorticity:   return "vrt";
+      default:              return "unknown";
+    }
+  }
+};
+
+#endif // _FFV_EXTRACT_H_
@@ -43,6 +43,8 @@
 #include "IntervalManager.h"
 #include "ffv_Define.h"
 #include "Component.h"
+#include "ffv_extract.h"
+#include "DeltaCheckpoint.h"
 
 #include "TextParser.h"
 
@@ -82,6 +84,12 @@ protected:
   string InDirPath;    ///< 入力ディレクトリパス
   string file_fmt_ext; ///< フォーマット識別子
   
+  vector<ExtractItem> ExtList; ///< 抽出出力のリスト
+  
+  int DeltaCkpt;             ///< 差分チェックポイント
+  IntervalManager CkptIntvl; ///< チェックポイントの出力タイミング
+  DeltaCheckpoint DCK;       ///< 差分チェックポイント
+  
   
   // variables
   REAL_TYPE* d_p;          ///< pressure
@@ -114,6 +122,10 @@ protected:
   REAL_TYPE* d_aT_mean;    ///< averaged 1D Turbulent transport rate
   REAL_TYPE* d_aPI_mean;   ///< averaged 1D velocity pressure-gradient term
   
+  double* d_prof_mean;     ///< averaged x-z plane profile of tensors (Packed)
+  double* d_prof_comp;     ///< compensation term of d_prof_mean (Packed)
+  size_t prof_n;           ///< number of elements of the profile
+  
   
   // class pointer
   Control* C;
@@ -139,6 +151,7 @@ public:
     output_vtk = 0;
     output_debug = 0;
     BVXcomp = true;  // 圧縮する
+    DeltaCkpt = OFF;
     
     // 変数
     d_p = NULL;
@@ -171,6 +184,10 @@ public:
     d_aE_mean   = NULL;
     d_aT_mean   = NULL;
     d_aPI_mean  = NULL;
+    
+    d_prof_mean = NULL;
+    d_prof_comp = NULL;
+    prof_n      = 0;
   }
   
   
@@ -196,6 +213,93 @@ protected:
   virtual void printSteerConditionsInherent(FILE* fp) {}
   
   
+  /**
+   * @brief 抽出変数の指定を確認
+   * @param [in] label Variablesノードのラベル
+   * @param [in] key   変数名
+   * @retval "on"の場合true
+   */
+  bool isExtractionVar(const string label, const string key);
+  
+  
+  /**
+   * @brief 自ランクの抽出点を次元変換しながらバッファに詰める
+   * @param [in]     e    抽出項目
+   * @param [in]     var  抽出変数
+   * @param [in]     nct  1点あたりの全成分数
+   * @param [in]     ofs  この変数の先頭成分の位置
+   * @param [out]    buf  送信バッファ
+   * @param [in,out] flop 浮動小数点演算数
+   */
+  void packExtraction(const ExtractItem& e,
+                      const int var,
+                      const int nct,
+                      const int ofs,
+                      REAL_TYPE* buf,
+                      double& flop);
+  
+  
+  /**
+   * @brief 抽出点をマスターランクに集約し，全体配列に並べる
+   * @param [in]  e    抽出項目
+   * @param [in]  nc   成分数
+   * @param [in]  sbuf 送信バッファ
+   * @param [out] gbuf 全体配列（マスターランクのみ）
+   */
+  void gatherExtraction(const ExtractItem& e, const int nc, REAL_TYPE* sbuf, REAL_TYPE* gbuf);
+  
+  
+  /**
+   * @brief 抽出点の格子ファイルと関数名ファイルを書き出す
+   * @param [in] e 抽出項目
+   * @note 抽出範囲は変わらないので，項目毎に最初の出力時に1回だけ書き出す
+   */
+  void writeExtractionGrid(const ExtractItem& e);
+  
+  
+  /**
+   * @brief 抽出データを全変数まとめて1つのPLOT3D関数ファイルに書き出す
+   * @param [in] e      抽出項目
+   * @param [in] nct    1点あたりの全成分数
+   * @param [in] gbuf   全体配列（成分が最内）
+   * @param [in] m_step ステップ
+   * @param [in] m_time 時刻
+   */
+  void writeExtractionFunc(const ExtractItem& e,
+                           const int nct,
+                           const REAL_TYPE* gbuf,
+                           const unsigned m_step,
+                           const REAL_TYPE m_time);
+  
+  
+  // チェックポイントの対象配列を登録
+  void registCheckpointFields();
+  
+  
+  // リスタートステップ
+  unsigned getRestartStep();
+  
+  
+  /**
+   * @brief 差分チェックポイントからグループを復元
+   * @param [in]  fp        ファイルポインタ
+   * @param [in]  group     復元するグループ
+   * @param [out] step      ステップ
+   * @param [out] time      時刻
+   * @param [out] step_stat 統計の積算ステップ数
+   * @param [out] time_stat 統計の積算時間
+   * @retval 復元した場合true，チェックポイントがない場合false
+   * @note チェックポイントはOutDirに書き出し，リスタート時はSPHファイルと同様にInDirから読む．
+   *       InDirには前セッションのOutDirを指定する．同一分割数・同一解像度のリスタートのみ対象
+   */
+  bool readCheckpoint(FILE* fp,
+                      const int group,
+                      unsigned& step,
+                      double& time,
+                      unsigned& step_stat,
+                      double& time_stat);
+  
+  
   // polylibファイルのグループ出力
   void writePolylibGrp(FILE* fp,
                        const string alias,
@@ -225,6 +329,147 @@ public:
 
   
   
+  /**
+   * @brief 抽出出力のパラメータを取得
+   * @pre setDomainInfo()
+   */
+  void getExtractionParams();
+  
+  
+  /**
+   * @brief 抽出出力のインターバルを初期化
+   * @param [in] m_start セッションの開始ステップ
+   * @param [in] m_last  セッションの最終ステップ
+   * @param [in] m_step  現在のステップ
+   * @param [in] m_time  現在の時刻
+   * @param [in] m_dt    時間積分幅
+   */
+  void initExtractionInterval(const unsigned m_start,
+                              const unsigned m_last,
+                              const unsigned m_step,
+                              const double m_time,
+                              const double m_dt);
+  
+  
+  // 抽出出力が指定されている場合true
+  bool isExtraction() const
+  {
+    return !ExtList.empty();
+  }
+  
+  
+  /**
+   * @brief 抽出出力
+   * @param [in]     m_CurrentStep CurrentStep
+   * @param [in]     m_CurrentTime CurrentTime
+   * @param [in,out] flop          浮動小数点演算数
+   * @note 全ランクでコールすること
+   */
+  void OutputExtraction(const unsigned m_CurrentStep,
+                        const double m_CurrentTime,
+                        double& flop);
+  
+  
+  // 抽出出力の表示
+  void printExtractionInfo(FILE* fp);
+  
+  
+  // 差分チェックポイントのパラメータを取得
+  void getCheckpointParams();
+  
+  
+  /**
+   * @brief 差分チェックポイントのインターバルを初期化
+   * @param [in] m_start セッションの開始ステップ
+   * @param [in] m_last  セッションの最終ステップ
+   * @param [in] m_step  現在のステップ
+   * @param [in] m_time  現在の時刻
+   * @param [in] m_dt    時間積分幅
+   */
+  void initCheckpointInterval(const unsigned m_start,
+                              const unsigned m_last,
+                              const unsigned m_step,
+                              const double m_time,
+                              const double m_dt);
+  
+  
+  // 差分チェックポイントが指定されている場合true
+  bool isCheckpoint() const
+  {
+    return (DeltaCkpt == ON) ? true : false;
+  }
+  
+  
+  // このステップが差分チェックポイントの出力間隔に当たる場合true
+  bool isCheckpointTriggered(const unsigned m_CurrentStep, const double m_CurrentTime)
+  {
+    return (DeltaCkpt == ON) && CkptIntvl.isTriggered(m_CurrentStep, m_CurrentTime);
+  }
+  
+  
+  /**
+   * @brief 差分チェックポイントの出力
+   * @param [in] m_CurrentStep     CurrentStep
+   * @param [in] m_CurrentTime     CurrentTime
+   * @param [in] m_CurrentStepStat CurrentStepStat
+   * @param [in] m_CurrentTimeStat CurrentTimeStat
+   * @param [in] force             出力間隔によらず出力する場合true
+   */
+  void OutputCheckpoint(const unsigned m_CurrentStep,
+                        const double m_CurrentTime,
+                        const unsigned m_CurrentStepStat,
+                        const double m_CurrentTimeStat,
+                        const bool force=false);
+  
+  
+  /**
+   * @brief 差分チェックポイントから瞬時値を復元
+   * @param [in]  fp            ファイルポインタ
+   * @param [out] m_CurrentStep CurrentStep
+   * @param [out] m_CurrentTime CurrentTime
+   * @retval 復元した場合true，チェックポイントがない場合false
+   */
+  bool RestartCheckpoint(FILE* fp,
+                         unsigned& m_CurrentStep,
+                         double& m_CurrentTime);
+  
+  
+  /**
+   * @brief 差分チェックポイントから統計値を復元
+   * @param [in]  fp                ファイルポインタ
+   * @param [out] m_CurrentStepStat CurrentStepStat
+   * @param [out] m_CurrentTimeStat CurrentTimeStat
+   * @retval 復元した場合true，チェックポイントがない場合false
+   */
+  bool RestartStatisticCheckpoint(FILE* fp,
+                                  unsigned& m_CurrentStepStat,
+                                  double& m_CurrentTimeStat);
+  
+  
+  /**
+   * @brief Packed形式のプロファイルを書き出す
+   * @param [in] m_CurrentStep     出力ステップ
+   * @param [in] m_CurrentStepStat CurrentStepStat
+   * @param [in] m_CurrentTimeStat CurrentTimeStat
+   * @note プロファイルはランク内のx-z面平均なので，ランク毎のバイナリファイルとする
+   */
+  void writeStatProfile(const unsigned m_CurrentStep,
+                        const unsigned m_CurrentStepStat,
+                        const double m_CurrentTimeStat);
+  
+  
+  /**
+   * @brief Packed形式のプロファイルを読み込む
+   * @param [in] fp                ファイルポインタ
+   * @param [in] m_RestartStep     リスタートステップ
+   * @param [in] m_CurrentStepStat 統計値ファイルから読んだCurrentStepStat
+   * @note 同一分割数・同一解像度のリスタートのみ
+   */
+  void readStatProfile(FILE* fp,
+                       const unsigned m_RestartStep,
+                       const unsigned m_CurrentStepStat);
+  
+  
   // formatを返す
   int getFormat() const
   {
@@ -395,6 +640,20 @@ public:
                       );
   
   
+  /**
+   * @brief Packed形式のプロファイル配列をセット
+   * @param [in] m_d_prof_mean 面平均プロファイルの時間平均値
+   * @param [in] m_d_prof_comp d_prof_meanの補償項
+   * @param [in] m_n           要素数
+   */
+  void setProfilePointers(double* m_d_prof_mean, double* m_d_prof_comp, const size_t m_n)
+  {
+    d_prof_mean = m_d_prof_mean;
+    d_prof_comp = m_d_prof_comp;
+    prof_n      = m_n;
+  }
+  
+  
   
   /**
    * @brief BCflagの書き出し
@@ -455,6 +714,7 @@ public:
    * @param [in]     d_aE              散逸項 (時間平均値)
    * @param [in]     d_aT              乱流拡散項 (時間平均値)
    * @param [in]     d_aPI             速度圧力勾配相関項 (時間平均値)
+   * @param [in]     prof_mean         テンソルの面平均プロファイル (Packed形式の場合, それ以外はNULL)
    * @param [in]     myRank            自ノードのランク番号
    * @param [in]     sz                領域サイズ (時間平均値)
    * @param [in]     CurrentStepStat   統計操作の積算ステップ数 (時間平均値)
@@ -469,6 +729,7 @@ public:
                           REAL_TYPE*        d_aE,
                           REAL_TYPE*        d_aT,
                           REAL_TYPE*        d_aPI,
+                          double*           prof_mean,
                           int               myRank,
                           int*              sz,
                           unsigned long int CurrentStepStat,
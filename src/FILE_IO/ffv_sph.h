@@ -142,6 +142,40 @@ public:
   
   
 private:
+  /**
+   * @brief 同一分割数・同一解像度のリスタートで自ランクのSPHファイルをマップして読み込む
+   * @param [in]  dfi      入力DFI
+   * @param [in]  dfi_name 入力DFIファイル名
+   * @param [in]  step     読み込むステップ
+   * @param [out] dst      転送先配列
+   * @param [out] r_time   ファイルに記録された時刻
+   * @retval true 読み込み完了, false 条件を満たさない（CDMlibの読み込みを使う）
+   * @note エンディアン変換と型変換はガイドセル付き配列への1回のコピーで行う
+   * @note 全ランクで成立した場合のみtrueを返す
+   */
+  bool readMappedSph(cdm_DFI* dfi,
+                     const string& dfi_name,
+                     const unsigned step,
+                     REAL_TYPE* dst,
+                     double& r_time);
+
+
+  /**
+   * @brief 自ランクのSPHファイルをマップして読み込む
+   * @param [in]  dfi      入力DFI
+   * @param [in]  dfi_name 入力DFIファイル名
+   * @param [in]  step     読み込むステップ
+   * @param [out] dst      転送先配列
+   * @param [out] r_time   ファイルに記録された時刻
+   * @retval true 読み込み完了
+   */
+  bool mapSphLocal(cdm_DFI* dfi,
+                   const string& dfi_name,
+                   const unsigned step,
+                   REAL_TYPE* dst,
+                   double& r_time);
+
+
   /**
    * @brief リスタート時の瞬時値ファイル読み込み
    * @param [in]  fp             ファイルポインタ
@@ -204,6 +238,7 @@ public:
    * @param [in]     d_aE              散逸項 (時間平均値)
    * @param [in]     d_aT              乱流拡散項 (時間平均値)
    * @param [in]     d_aPI             速度圧力勾配相関項 (時間平均値)
+   * @param [in]     prof_mean         テンソルの面平均プロファイル (Packed形式の場合, それ以外はNULL)
    * @param [in]     myRank            自ノードのランク番号
    * @param [in]     sz                領域サイズ (時間平均値)
    * @param [in]     CurrentStepStat   統計操作の積算ステップ数 (時間平均値)
@@ -218,6 +253,7 @@ public:
                           REAL_TYPE*         d_aE,
                           REAL_TYPE*         d_aT,
                           REAL_TYPE*         d_aPI,
+                          double*            prof_mean,
                           int                myRank,
                           int*               sz,
                           unsigned long int  CurrentStepStat,
@@ -841,9 +841,9 @@ end subroutine fb_vin_ijkn
 
     actv = real(ibits(bx(i,j,k), State, 1))
     
-    !u = dble(vn(i,j,k,1))
-    !v = dble(vn(i,j,k,2))
-    !w = dble(vn(i,j,k,3))
+    u = dble(vn(i,j,k,1))
+    v = dble(vn(i,j,k,2))
+    w = dble(vn(i,j,k,3))
     !av = av + sqrt(u*u + v*v + w*w)*actv
     
     x = u - dble(vo(i,j,k,1))
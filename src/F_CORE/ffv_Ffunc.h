@@ -44,6 +44,7 @@
 #define ps_muscl_           PS_MUSCL
 #define ps_buoyancy_        PS_BUOYANCY
 #define ps_diff_ee_         PS_DIFF_EE
+#define ps_average_vf_      PS_AVERAGE_VF
 #define hbc_drchlt_         HBC_DRCHLT
 
 // ffv_vbc_inner.f90
@@ -85,6 +86,11 @@
 #define pvec_central_les_   PVEC_CENTRAL_LES
 #define update_vec_         UPDATE_VEC
 #define update_vec4_        UPDATE_VEC4
+#define update_vec_diag_    UPDATE_VEC_DIAG
+#define steady_lts_incr_    STEADY_LTS_INCR
+#define steady_lts_smooth_  STEADY_LTS_SMOOTH
+#define steady_lts_update_  STEADY_LTS_UPDATE
+#define steady_lts_face_    STEADY_LTS_FACE
 #define update_face_vec_    UPDATA_FACE_VEC
 #define predict_face_vec_   PREDICT_FACE_VEC
 #define update_cc_vec_      UPDATE_CC_VEC
@@ -93,6 +99,7 @@
 // ffv_utility.f90
 #define norm_v_div_l2_      NORM_V_DIV_L2
 #define norm_v_div_max_     NORM_V_DIV_MAX
+#define norm_v_div_lst_     NORM_V_DIV_LST
 #define helicity_           HELICITY
 #define i2vgt_              I2VGT
 #define rot_v_              ROT_V
@@ -106,6 +113,8 @@
 #define calc_dissipation_rate_    CALC_DISSIPATION_RATE
 #define calc_turb_transport_rate_ CALC_TURB_TRANSPORT_RATE
 #define calc_vel_pregrad_term_    CALC_VEL_PREGRAD_TERM
+#define calc_turb_statistics_fused_ CALC_TURB_STATISTICS_FUSED
+#define stat_profile_update_      STAT_PROFILE_UPDATE
 #define averaging_xz_plane_       AVERAGING_XZ_PLANE
 #define perturbu_           PERTURBU
 #define generate_iblank_    GENERATE_IBLANK
@@ -156,14 +165,15 @@
 extern "C" {
   //***********************************************************************************************
   // ffv_forcing.f90
-  void hex_dir_(REAL_TYPE* v, int* sz, int* g, int* st, int* ed, int* bd, REAL_TYPE* vf, int* odr, REAL_TYPE* v00, REAL_TYPE* nv, double* flop);
+  void hex_dir_(REAL_TYPE* v, int* sz, int* g, int* nl, int* lst, int* bd, REAL_TYPE* vf, int* odr, REAL_TYPE* v00, REAL_TYPE* nv, double* flop);
   void force_keep_vec_(REAL_TYPE* wk, int* c_sz, int* st, int* ed, REAL_TYPE* v, int* sz, int* g);
   
   void hex_psrc_ (REAL_TYPE* src,
                   int* sz,
                   int* g,
                   int* st,
-                  int* ed,
+                  int* nl,
+                  int* lst,
                   int* bd,
                   REAL_TYPE* vf,
                   REAL_TYPE* wk,
@@ -177,8 +187,8 @@ extern "C" {
   void hex_force_pvec_ (REAL_TYPE* vc,
                         int* sz,
                         int* g,
-                        int* st,
-                        int* ed,
+                        int* nl,
+                        int* lst,
                         int* bd,
                         REAL_TYPE* vf,
                         REAL_TYPE* v,
@@ -194,7 +204,8 @@ extern "C" {
                        int* sz,
                        int* g,
                        int* st,
-                       int* ed,
+                       int* nl,
+                       int* lst,
                        int* bd,
                        REAL_TYPE* vf,
                        REAL_TYPE* wk,
@@ -269,6 +280,13 @@ extern "C" {
                     int* h_mode,
                     double* flop);
   
+  void ps_average_vf_ (REAL_TYPE* avr,
+                       int* sz,
+                       int* g,
+                       REAL_TYPE* vf,
+                       REAL_TYPE* nadd,
+                       double* flop);
+  
   
   
   //***********************************************************************************************
@@ -299,41 +317,38 @@ extern "C" {
   void pvec_ibc_oflow_ (REAL_TYPE* wv,
                         int* sz,
                         int* g,
-                        int* st,
-                        int* ed,
+                        int* nl,
+                        int* lst,
                         REAL_TYPE* dh,
                         REAL_TYPE* rei,
                         REAL_TYPE* v,
                         int* bv,
-                        int* odr,
                         REAL_TYPE* vec,
                         double* flop);
   
   void pvec_ibc_specv_fvm_ (REAL_TYPE* wv,
                             int* sz,
                             int* g,
-                            int* st,
-                            int* ed,
+                            int* nl,
+                            int* lst,
                             REAL_TYPE* dh,
                             REAL_TYPE* v00,
                             REAL_TYPE* rei,
                             REAL_TYPE* v,
                             int* bv,
-                            int* odr,
                             REAL_TYPE* vec,
                             double* flop);
   
   void pvec_ibc_specv_fdm_ (REAL_TYPE* wv,
                             int* sz,
                             int* g,
-                            int* st,
-                            int* ed,
+                            int* nl,
+                            int* lst,
                             REAL_TYPE* dh,
                             REAL_TYPE* v00,
                             REAL_TYPE* rei,
                             REAL_TYPE* v,
                             int* bv,
-                            int* odr,
                             REAL_TYPE* vec,
                             double* flop);
   
@@ -341,25 +356,23 @@ extern "C" {
                            int* sz,
                            int* g,
                            REAL_TYPE* dh,
-                           int* st,
-                           int* ed,
+                           int* nl,
+                           int* lst,
                            REAL_TYPE* v00,
                            int* bv,
-                           int* odr,
                            REAL_TYPE* vec,
                            double* flop);
   
   void div_ibc_oflow_pvec_(REAL_TYPE* div,
                            int* sz,
                            int* g,
-                           int* st,
-                           int* ed,
+                           int* nl,
+                           int* lst,
                            REAL_TYPE* v00,
                            REAL_TYPE* v_cnv,
                            REAL_TYPE* dt,
                            REAL_TYPE* dh,
                            int* bv,
-                           int* odr,
                            REAL_TYPE* v0,
                            REAL_TYPE* vf,
                            double* flop);
@@ -368,23 +381,21 @@ extern "C" {
                            int* sz,
                            int* g,
                            REAL_TYPE* dh,
-                           int* st,
-                           int* ed,
+                           int* nl,
+                           int* lst,
                            int* bv,
-                           int* odr,
                            REAL_TYPE* av,
                            double* flop);
   
   void pvec_ibc_sldrev_fvm_ (REAL_TYPE* wv,
                              int* sz,
                              int* g,
-                             int* st,
-                             int* ed,
+                             int* nl,
+                             int* lst,
                              REAL_TYPE* dh,
                              REAL_TYPE* rei,
                              REAL_TYPE* v,
                              int* bv,
-                             int* odr,
                              REAL_TYPE* vec,
                              REAL_TYPE* ctr,
                              REAL_TYPE* org,
@@ -393,12 +404,11 @@ extern "C" {
   void div_ibc_sldrev_ (REAL_TYPE* div,
                         int* sz,
                         int* g,
-                        int* st,
-                        int* ed,
+                        int* nl,
+                        int* lst,
                         REAL_TYPE* pch,
                         REAL_TYPE* v00,
                         int* bv,
-                        int* odr,
                         REAL_TYPE* vec,
                         REAL_TYPE* ctr,
                         REAL_TYPE* org,
@@ -598,6 +608,65 @@ extern "C" {
                     int* bcd,
                     double* flop);
   
+  void update_vec_diag_ (REAL_TYPE* v,
+                         REAL_TYPE* vf,
+                         REAL_TYPE* div,
+                         int* sz,
+                         int* g,
+                         REAL_TYPE* dt,
+                         REAL_TYPE* dh,
+                         REAL_TYPE* vc,
+                         REAL_TYPE* p,
+                         int* bp,
+                         int* bcd,
+                         REAL_TYPE* v0,
+                         REAL_TYPE* p0,
+                         REAL_TYPE* v00,
+                         REAL_TYPE* cm,
+                         double* dg,
+                         double* flop);
+  
+  void steady_lts_incr_ (REAL_TYPE* dv,
+                         int* sz,
+                         int* g,
+                         REAL_TYPE* v,
+                         REAL_TYPE* v0,
+                         REAL_TYPE* v00,
+                         REAL_TYPE* dt,
+                         REAL_TYPE* cfl,
+                         REAL_TYPE* dx,
+                         int* bcd,
+                         double* flop);
+  
+  void steady_lts_smooth_ (REAL_TYPE* dv,
+                           int* sz,
+                           int* g,
+                           REAL_TYPE* d0,
+                           REAL_TYPE* eps,
+                           int* bcd,
+                           int* ip,
+                           int* color,
+                           double* flop);
+  
+  void steady_lts_update_ (REAL_TYPE* v,
+                           int* sz,
+                           int* g,
+                           REAL_TYPE* v0,
+                           REAL_TYPE* dv,
+                           int* bcd,
+                           double* flop);
+  
+  void steady_lts_face_ (REAL_TYPE* vf,
+                         int* sz,
+                         int* g,
+                         REAL_TYPE* vf0,
+                         REAL_TYPE* v0,
+                         REAL_TYPE* v00,
+                         REAL_TYPE* dt,
+                         REAL_TYPE* cfl,
+                         REAL_TYPE* dx,
+                         double* flop);
+  
   void update_vec4_ (REAL_TYPE* v,
                      REAL_TYPE* vf,
                      REAL_TYPE* div,
@@ -699,6 +768,18 @@ extern "C" {
                            REAL_TYPE* cm,
                            double* flop);
   
+  void norm_v_div_lst_ (double* ds,
+                        int* sz,
+                        int* g,
+                        REAL_TYPE* div,
+                        int* bp,
+                        REAL_TYPE* p,
+                        REAL_TYPE* p0,
+                        REAL_TYPE* cm,
+                        int* nl,
+                        int* lst,
+                        double* flop);
+  
   void helicity_ (REAL_TYPE* ht,
                   int* sz, int* g,
                   REAL_TYPE* dh,
@@ -816,6 +897,42 @@ extern "C" {
                                int* bp,
                                REAL_TYPE* nadd,
                                double* flop);
+  
+  void calc_turb_statistics_fused_ (REAL_TYPE* v_ave,
+                                    REAL_TYPE* ap,
+                                    REAL_TYPE* rms_v,
+                                    REAL_TYPE* rmsmean_v,
+                                    REAL_TYPE* rms_p,
+                                    REAL_TYPE* rmsmean_p,
+                                    REAL_TYPE* R,
+                                    int* nr,
+                                    REAL_TYPE* R_ave,
+                                    REAL_TYPE* P_ave,
+                                    REAL_TYPE* E_ave,
+                                    REAL_TYPE* T_ave,
+                                    REAL_TYPE* PI_ave,
+                                    double* prof,
+                                    int* sz,
+                                    REAL_TYPE* dh,
+                                    int* g,
+                                    REAL_TYPE* nu,
+                                    REAL_TYPE* v,
+                                    REAL_TYPE* p,
+                                    int* bid,
+                                    int* bp,
+                                    int* sw_v,
+                                    int* sw_p,
+                                    int* sw_pk,
+                                    REAL_TYPE* nadd,
+                                    double* flop);
+  
+  void stat_profile_update_ (double* pm,
+                             double* pc,
+                             double* ps,
+                             int* n,
+                             double* scale,
+                             REAL_TYPE* nadd,
+                             double* flop);
 
   void averaging_xz_plane_ (REAL_TYPE* vmean,
                             REAL_TYPE* rmsmean,
@@ -833,6 +950,7 @@ extern "C" {
                             REAL_TYPE* E_ave,
                             REAL_TYPE* T_ave,
                             REAL_TYPE* PI_ave,
+                            int* sw_pk,
                             double* flop
                             );
 
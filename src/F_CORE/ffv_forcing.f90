@@ -25,21 +25,22 @@
 !! @param v 速度ベクトル タイムレベルn
 !! @param sz 配列長
 !! @param g ガイドセル長
-!! @param st ループの開始インデクス
-!! @param ed ループの終了インデクス
+!! @param nl セルリストの要素数
+!! @param lst セルリスト (i, j, k, 面フラグ)
 !! @param bd BCindex B
 !! @param vf コンポーネントの体積率
 !! @param odr 速度境界条件のエントリ
 !! @param v00 参照速度
 !! @param nv 法線ベクトル
 !! @param[out] flop flop count
+!! @note コンポーネントに属するセルのみ処理
 !<
-    subroutine hex_dir (v, sz, g, st, ed, bd, vf, odr, v00, nv, flop)
+    subroutine hex_dir (v, sz, g, nl, lst, bd, vf, odr, v00, nv, flop)
     implicit none
     include 'ffv_f_params.h'
-    integer                                                     ::  i, j, k, g, idx, odr
-    integer                                                     ::  is, ie, js, je, ks, ke
-    integer, dimension(3)                                       ::  sz, st, ed
+    integer                                                     ::  i, j, k, g, idx, odr, nl, l
+    integer, dimension(3)                                       ::  sz
+    integer, dimension(4, nl)                                   ::  lst
     double precision                                            ::  flop
     real                                                        ::  u_ref, v_ref, w_ref, es, bes
     real                                                        ::  nx, ny, nz, b0, r_bt, uu, u1, u2, u3
@@ -56,22 +57,18 @@
     ny = nv(2)
     nz = nv(3)
 
-    is = st(1)
-    ie = ed(1)
-    js = st(2)
-    je = ed(2)
-    ks = st(3)
-    ke = ed(3)
-
 !$OMP PARALLEL &
-!$OMP FIRSTPRIVATE(is, ie, js, je, ks, ke, u_ref, v_ref, w_ref, odr) &
+!$OMP FIRSTPRIVATE(u_ref, v_ref, w_ref, odr) &
 !$OMP FIRSTPRIVATE(nx, ny, nz) &
+!$OMP PRIVATE(i, j, k) &
 !$OMP PRIVATE(idx, b0, es, bes, u1, u2, u3, r_bt, uu)
 !$OMP DO SCHEDULE(static)
 
-    do k=ks,ke
-    do j=js,je
-    do i=is,ie
+    do l=1,nl
+      if ( .not. btest(lst(4,l), cell_self) ) cycle
+      i = lst(1,l)
+      j = lst(2,l)
+      k = lst(3,l)
       idx = bd(i,j,k)
       b0 = vf(i,j,k)
       es = 0.0
@@ -91,12 +88,10 @@
       v(i,j,k,3) = (r_bt*u3 + uu*nz) + w_ref
 
     end do
-    end do
-    end do
 !$OMP END DO
 !$OMP END PARALLEL
 
-    flop = flop + dble(ie-is+1)*(je-js+1)*(ke-ks+1)*24.0d0
+    flop = flop + dble(nl)*24.0d0
 
     return
     end subroutine hex_dir
@@ -159,8 +154,9 @@
 !! @param [in,out] src  反復ソース項 \sum {\beta F}
 !! @param [in]     sz   配列長
 !! @param [in]     g    ガイドセル長
-!! @param [in]     st   ループの開始インデクス
-!! @param [in]     ed   ループの終了インデクス
+!! @param [in]     st   コンポーネントのBboxの開始インデクス（wkの原点）
+!! @param [in]     nl   セルリストの要素数
+!! @param [in]     lst  セルリスト (i, j, k, 面フラグ)
 !! @param [in]     bd   BCindex B
 !! @param [in]     vf   コンポーネントの体積率
 !! @param [in]     wk   テンポラリのワークベクトル 速度ベクトル
@@ -170,13 +166,15 @@
 !! @param [in]     nv   法線ベクトル
 !! @param [in]     c    圧力損失部の係数
 !! @param [out]    flop flop count
+!! @note リストは周囲1セルを含めて，自セルか隣接セルがコンポーネントに属すセル
 !<
-    subroutine hex_psrc (src, sz, g, st, ed, bd, vf, wk, cz, odr, v00, nv, c, flop)
+    subroutine hex_psrc (src, sz, g, st, nl, lst, bd, vf, wk, cz, odr, v00, nv, c, flop)
     implicit none
     include 'ffv_f_params.h'
-    integer                                                     ::  i, j, k, g, ii, jj, kk, idx, odr
-    integer                                                     ::  is, ie, js, je, ks, ke
-    integer, dimension(3)                                       ::  sz, st, ed, cz
+    integer                                                     ::  i, j, k, g, ii, jj, kk, idx, odr, nl, l
+    integer                                                     ::  is, js, ks
+    integer, dimension(3)                                       ::  sz, st, cz
+    integer, dimension(4, nl)                                   ::  lst
     double precision                                            ::  flop
     real                                                        ::  u_ref, v_ref, w_ref
     real                                                        ::  u_w, u_e, u_s, u_n, u_b, u_t, u_p
@@ -213,15 +211,13 @@
     ep = c(5)         ! threshold
 
     is = st(1)
-    ie = ed(1)
     js = st(2)
-    je = ed(2)
     ks = st(3)
-    ke = ed(3)
 
 !$OMP PARALLEL &
-!$OMP FIRSTPRIVATE(is, ie, js, je, ks, ke, u_ref, v_ref, w_ref, odr) &
+!$OMP FIRSTPRIVATE(is, js, ks, u_ref, v_ref, w_ref, odr) &
 !$OMP FIRSTPRIVATE(nx, ny, nz, c1, c2, c3, c4, ep) &
+!$OMP PRIVATE(i, j, k) &
 !$OMP PRIVATE(idx, pick, es, ii, jj, kk) &
 !$OMP PRIVATE(be, bw, bn, bs, bt, bb, b0) &
 !$OMP PRIVATE(u_w, u_e, u_s, u_n, u_b, u_t, u_p) &
@@ -235,17 +231,16 @@
 !$OMP PRIVATE(re, rw, rn, rs, rt, rb) &
 !$OMP PRIVATE(q_w, q_e, q_s, q_n, q_b, q_t, q_p, qq)
 
-    ! 周囲の1セルを含めてサーチ
+    ! 周囲の1セルを含めたリストのセルを処理
 !$OMP DO SCHEDULE(static)
 
-    do k=ks-1,ke+1
-      kk = k - ks + 1
-
-    do j=js-1,je+1
-      jj = j - js + 1
-
-    do i=is-1,ie+1
+    do l=1,nl
+      i = lst(1,l)
+      j = lst(2,l)
+      k = lst(3,l)
       ii = i - is + 1
+      jj = j - js + 1
+      kk = k - ks + 1
 
       ! 自セルが流体で、かつ周囲1セルの範囲にコンポーネントが存在する場合のみ有効
       pick = 0.0
@@ -257,12 +252,10 @@
 
       src(i,j,k) = ( be*re - bw*rw + bn*rn - bs*rs + bt*rt - bb*rb ) * es ! esはマスク
     end do
-    end do
-    end do
 !$OMP END DO
 !$OMP END PARALLEL
     
-    flop = flop + dble(cz(1)+2)*(cz(2)+2)*(cz(3)+2)*200.0d0
+    flop = flop + dble(nl)*200.0d0
 
     return
     end subroutine hex_psrc
@@ -272,8 +265,8 @@
 !! @param[in,out] vc 擬似速度ベクトル
 !! @param sz 配列長
 !! @param g ガイドセル長
-!! @param st ループの開始インデクス
-!! @param ed ループの終了インデクス
+!! @param nl セルリストの要素数
+!! @param lst セルリスト (i, j, k, 面フラグ)
 !! @param bd BCindex B
 !! @param vf コンポーネントの体積率
 !! @param v 速度ベクトル タイムレベルn
@@ -283,13 +276,14 @@
 !! @param nv 法線ベクトル
 !! @param c 圧力損失部の係数
 !! @param[out] flop flop count
+!! @note コンポーネントに属するセルのみ処理
 !<
-    subroutine hex_force_pvec (vc, sz, g, st, ed, bd, vf, v, odr, v00, dt, nv, c, flop)
+    subroutine hex_force_pvec (vc, sz, g, nl, lst, bd, vf, v, odr, v00, dt, nv, c, flop)
     implicit none
     include 'ffv_f_params.h'
-    integer                                                     ::  i, j, k, g, idx, odr
-    integer                                                     ::  is, ie, js, je, ks, ke
-    integer, dimension(3)                                       ::  sz, st, ed
+    integer                                                     ::  i, j, k, g, idx, odr, nl, l
+    integer, dimension(3)                                       ::  sz
+    integer, dimension(4, nl)                                   ::  lst
     double precision                                            ::  flop
     real                                                        ::  dt, cf
     real                                                        ::  u_ref, v_ref, w_ref, es
@@ -316,23 +310,19 @@
     ep = c(5)         ! threshold
     cf = 0.5*dt
 
-    is = st(1)
-    ie = ed(1)
-    js = st(2)
-    je = ed(2)
-    ks = st(3)
-    ke = ed(3)
-
 !$OMP PARALLEL &
-!$OMP FIRSTPRIVATE(is, ie, js, je, ks, ke, u_ref, v_ref, w_ref, odr, cf) &
+!$OMP FIRSTPRIVATE(u_ref, v_ref, w_ref, odr, cf) &
 !$OMP FIRSTPRIVATE(nx, ny, nz, c1, c2, c3, c4, ep) &
+!$OMP PRIVATE(i, j, k) &
 !$OMP PRIVATE(idx, b0, d_b, u_p, v_p, w_p, g_p, d_p, Fx_p, Fy_p, Fz_p) &
 !$OMP PRIVATE(r_bt, uu, u1, u2, u3, es, bes)
 
 !$OMP DO SCHEDULE(static)
-    do k=ks,ke
-    do j=js,je
-    do i=is,ie
+    do l=1,nl
+      if ( .not. btest(lst(4,l), cell_self) ) cycle
+      i = lst(1,l)
+      j = lst(2,l)
+      k = lst(3,l)
       idx = bd(i,j,k)
       b0 = vf(i,j,k)
       es = 0.0
@@ -367,12 +357,10 @@
       vc(i,j,k,3) = u3 + d_b * Fz_p
 
     end do
-    end do
-    end do
 !$OMP END DO
 !$OMP END PARALLEL
 
-    flop = flop + dble(ie-is+1)*(je-js+1)*(ke-ks+1)*55.0d0
+    flop = flop + dble(nl)*55.0d0
 
     return
     end subroutine hex_force_pvec
@@ -383,8 +371,9 @@
 !! @param [in,out] div  速度の発散
 !! @param [in]     sz   配列長
 !! @param [in]     g    ガイドセル長
-!! @param [in]     st   ループの開始インデクス
-!! @param [in]     ed   ループの終了インデクス
+!! @param [in]     st   コンポーネントのBboxの開始インデクス（wkの原点）
+!! @param [in]     nl   セルリストの要素数
+!! @param [in]     lst  セルリスト (i, j, k, 面フラグ)
 !! @param [in]     bd   BCindex B
 !! @param [in]     vf   コンポーネントの体積率
 !! @param [in]     wk   テンポラリのワークベクトル 速度ベクトル (n+1,k)
@@ -397,13 +386,15 @@
 !! @param [in]     c    圧力損失部の係数
 !! @param [in]     am   平均速度と圧損量
 !! @param [out]    flop flop count
+!! @note リストは周囲1セルを含めて，自セルか隣接セルがコンポーネントに属すセル
 !<
-    subroutine hex_force_vec (v, div, sz, g, st, ed, bd, vf, wk, cz, odr, v00, dt, dh, nv, c, am, flop)
+    subroutine hex_force_vec (v, div, sz, g, st, nl, lst, bd, vf, wk, cz, odr, v00, dt, dh, nv, c, am, flop)
     implicit none
     include 'ffv_f_params.h'
-    integer                                                     ::  i, j, k, g, ii, jj, kk, idx, odr
-    integer                                                     ::  is, ie, js, je, ks, ke
-    integer, dimension(3)                                       ::  sz, st, ed, cz
+    integer                                                     ::  i, j, k, g, ii, jj, kk, idx, odr, nl, l
+    integer                                                     ::  is, js, ks
+    integer, dimension(3)                                       ::  sz, st, cz
+    integer, dimension(4, nl)                                   ::  lst
     double precision                                            ::  flop
     real                                                        ::  dt, beta
     real                                                        ::  u_ref, v_ref, w_ref
@@ -443,11 +434,8 @@
     ep = c(5)         ! threshold
 
     is = st(1)
-    ie = ed(1)
     js = st(2)
-    je = ed(2)
     ks = st(3)
-    ke = ed(3)
 
     am1 = 0.0 ! 通過速度の積算値
     am2 = 0.0 ! 圧損量の積算値
@@ -455,8 +443,9 @@
 !$OMP PARALLEL &
 !$OMP REDUCTION(+:am1) &
 !$OMP REDUCTION(+:am2) &
-!$OMP FIRSTPRIVATE(is, ie, js, je, ks, ke, u_ref, v_ref, w_ref, odr, dt) &
+!$OMP FIRSTPRIVATE(is, js, ks, u_ref, v_ref, w_ref, odr, dt) &
 !$OMP FIRSTPRIVATE(nx, ny, nz, c1, c2, c3, c4, ep) &
+!$OMP PRIVATE(i, j, k) &
 !$OMP PRIVATE(idx, es, beta, pick, ii, jj, kk) &
 !$OMP PRIVATE(be, bw, bn, bs, bt, bb, b0) &
 !$OMP PRIVATE(u_w, u_e, u_s, u_n, u_b, u_t, u_p) &
@@ -470,17 +459,16 @@
 !$OMP PRIVATE(re, rw, rn, rs, rt, rb) &
 !$OMP PRIVATE(q_w, q_e, q_s, q_n, q_b, q_t, q_p)
 
-! 周囲の1セルを含めてサーチ
+! 周囲の1セルを含めたリストのセルを処理
 !$OMP DO SCHEDULE(static)
 
-    do k=ks-1,ke+1
-      kk = k - ks + 1
-
-    do j=js-1,je+1
-      jj = j - js + 1
-
-    do i=is-1,ie+1
+    do l=1,nl
+      i = lst(1,l)
+      j = lst(2,l)
+      k = lst(3,l)
       ii = i - is + 1
+      jj = j - js + 1
+      kk = k - ks + 1
 
       ! 自セルが流体で、かつ周囲1セルの範囲にコンポーネントが存在する場合のみ有効
       pick = 0.0
@@ -501,12 +489,10 @@
       am2 = am2 + d_p * q_p
       
     end do
-    end do
-    end do
 !$OMP END DO
 !$OMP END PARALLEL
 
-    flop = flop + dble(ie-is+3)*(je-js+3)*(ke-ks+3)*213.0d0
+    flop = flop + dble(nl)*213.0d0
 
     am(1) = am1 ! accumulated velocity
     am(2) = am2 ! accumulated pressure loss
@@ -440,6 +440,54 @@ end subroutine ps_convection_ee
 
 
 
+!> ********************************************************************
+!! @brief 熱の多重時間刻みのためのセルフェイス速度の時間平均
+!! @param [in,out] avr   セルフェイス速度の平均値
+!! @param [in]     sz    配列長
+!! @param [in]     g     ガイドセル長
+!! @param [in]     vf    セルフェイス速度
+!! @param [in]     nadd  加算回数（1で上書き）
+!! @param [in,out] flop  浮動小数点演算数
+!! @note ps_muscl()が参照する0番目のフェイスも含める
+!<
+subroutine ps_average_vf(avr, sz, g, vf, nadd, flop)
+implicit none
+integer                                                   ::  i, j, k, ix, jx, kx, g
+integer, dimension(3)                                     ::  sz
+double precision                                          ::  flop
+real                                                      ::  nadd, val1, val2
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g, 3) ::  avr, vf
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+flop = flop + dble(ix+1)*dble(jx+1)*dble(kx+1)*9.0d0 + 2.0d0
+
+val2 = 1.0/nadd
+val1 = 1.0 - val2
+
+!$OMP PARALLEL &
+!$OMP FIRSTPRIVATE(ix, jx, kx, val1, val2)
+
+!$OMP DO SCHEDULE(static)
+do k=0,kx
+do j=0,jx
+do i=0,ix
+  avr(i,j,k,1) = val1 * avr(i,j,k,1) + val2 * vf(i,j,k,1)
+  avr(i,j,k,2) = val1 * avr(i,j,k,2) + val2 * vf(i,j,k,2)
+  avr(i,j,k,3) = val1 * avr(i,j,k,3) + val2 * vf(i,j,k,3)
+end do
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+return
+end subroutine ps_average_vf
+
+
+
 !> ********************************************************************
 !! @brief 温度の拡散項の半陰的時間積分（対流項を積分した結果を用いて粘性項を計算）
 !! @param [in,out] ie     内部エネルギー
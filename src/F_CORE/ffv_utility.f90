@@ -218,6 +218,64 @@ end subroutine norm_v_div_max
     end subroutine norm_v_div_max_lc
 
 
+!> ********************************************************************
+!! @brief リストのセルに対する発散の最大値と自乗和を計算
+!! @param [out] ds   (1) 最大値 (2) 自乗和
+!! @param [in]  sz   配列長
+!! @param [in]  g    ガイドセル長
+!! @param [in]  div  発散値
+!! @param [in]  bp   BCindex P
+!! @param [in]  p    圧力 p^{n+1}
+!! @param [in]  p0   圧力 p^{n}
+!! @param [in]  cm   係数 mach^2/dt（非圧縮の場合 0）
+!! @param [in]  nl   リストの要素数
+!! @param [in]  lst  セルリスト (i, j, k)
+!! @param [out] flop flop count
+!! @note update_vec_diag()で除外したセルを集計する
+!<
+    subroutine norm_v_div_lst (ds, sz, g, div, bp, p, p0, cm, nl, lst, flop)
+    implicit none
+    include 'ffv_f_params.h'
+    integer                                                   ::  i, j, k, l, nl, g
+    integer, dimension(3)                                     ::  sz
+    double precision                                          ::  flop, sq
+    real                                                      ::  mx, r, cm, cs
+    real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  div, p, p0
+    integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bp
+    integer, dimension(3, nl)                                 ::  lst
+    double precision, dimension(2)                            ::  ds
+
+    mx = 0.0
+    sq = 0.0
+    cs = cm
+
+    flop = flop + dble(nl)*8.0d0
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(i, j, k, r) &
+!$OMP REDUCTION(max:mx) &
+!$OMP REDUCTION(+:sq) &
+!$OMP FIRSTPRIVATE(nl, cs)
+
+!$OMP DO SCHEDULE(static)
+    do l=1,nl
+      i = lst(1,l)
+      j = lst(2,l)
+      k = lst(3,l)
+      r = ( div(i,j,k) + cs * (p(i,j,k) - p0(i,j,k)) ) * real(ibits(bp(i,j,k), State, 1))
+      mx = max(mx, abs(r))
+      sq = sq + dble(r*r)
+    end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+    ds(1) = dble(mx)
+    ds(2) = sq
+
+    return
+    end subroutine norm_v_div_lst
+
+
 !> ********************************************************************
 !! @brief 速度成分の最大値を計算する
 !! @param [out] v_max 最大値
@@ -1050,7 +1108,7 @@ kx = sz(3)
 val2 = 1.0/accum
 val1 = 1.0 - val2
 
-flop = flop + dble(ix+2*g) * dble(jx+2*g) * dble(kx+2*g) * 45.0d0 + 9.0d0
+flop = flop + dble(ix+2*g) * dble(jx+2*g) * dble(kx+2*g) * 12.0d0 + 9.0d0
 
 !$OMP PARALLEL &
 !$OMP PRIVATE(u1, u2, u3) &
@@ -1063,9 +1121,9 @@ do i = 1-g, ix+g
 u1 = v(i, j, k, 1) - av(i, j, k, 1)
 u2 = v(i, j, k, 2) - av(i, j, k, 2)
 u3 = v(i, j, k, 3) - av(i, j, k, 3)
-u1 = sqrt( u1*u1 )
-u2 = sqrt( u2*u2 )
-u3 = sqrt( u3*u3 )
+u1 = abs( u1 )
+u2 = abs( u2 )
+u3 = abs( u3 )
 
 ! 瞬間の標準偏差
 rms(i, j, k, 1) = u1
@@ -1118,7 +1176,7 @@ kx = sz(3)
 val2 = 1.0/accum
 val1 = 1.0 - val2
 
-flop = flop + dble(ix+2*g) * dble(jx+2*g) * dble(kx+2*g) * 15.0d0 + 9.0d0
+flop = flop + dble(ix+2*g) * dble(jx+2*g) * dble(kx+2*g) * 4.0d0 + 9.0d0
 
 !$OMP PARALLEL &
 !$OMP PRIVATE(u, u2) &
@@ -1129,7 +1187,7 @@ do k = 1-g, kx+g
 do j = 1-g, jx+g
 do i = 1-g, ix+g
 u = s(i, j, k) - as(i, j, k)
-u2 = sqrt( u*u )
+u2 = abs( u )
 
 ! 瞬間の標準偏差
 rms(i, j, k) = u2
@@ -2525,10 +2583,524 @@ end subroutine calc_vel_pregrad_term
 !> ********************************************************************
 
 
+
+
+!> ********************************************************************
+!! @brief 乱流統計量の一括更新（時間平均，変動値，レイノルズ応力とその収支項）
+!! @param [in,out] v_ave     セルセンター時間平均速度ベクトル
+!! @param [in,out] ap        セルセンター時間平均圧力
+!! @param [out]    rms_v     瞬間の変動速度
+!! @param [in,out] rmsmean_v 変動速度の時間平均値
+!! @param [out]    rms_p     瞬間の変動圧力
+!! @param [in,out] rmsmean_p 変動圧力の時間平均値
+!! @param [out]    R         レイノルズ応力テンソル（k面のリングバッファ）
+!! @param [in]     nr        Rが保持するk面の数 (kblk+g+2)
+!! @param [in,out] R_ave     レイノルズ応力テンソル (時間平均値)
+!! @param [in,out] P_ave     生成項 (時間平均値)
+!! @param [in,out] E_ave     散逸項 (時間平均値)
+!! @param [in,out] T_ave     乱流拡散項 (時間平均値)
+!! @param [in,out] PI_ave    速度圧力勾配相関項 (時間平均値)
+!! @param [out]    prof      x-z面内の総和 (R, P, E, T, PIの順に6成分ずつ)
+!! @param [in]     sz        配列長
+!! @param [in]     dh        格子幅
+!! @param [in]     g         ガイドセル長
+!! @param [in]     nu        動粘性係数
+!! @param [in]     v         セルセンター速度ベクトル
+!! @param [in]     p         セルセンター圧力
+!! @param [in]     bid       Cut ID
+!! @param [in]     bp        BCindex P
+!! @param [in]     sw_v      速度変動の統計 (0-off / 1-on)
+!! @param [in]     sw_p      圧力変動の統計 (0-off / 1-on)
+!! @param [in]     sw_pk     テンソルの保持形式 (0-セル毎の時間平均 / 1-x-z面内の総和profのみ)
+!! @param [in]     nadd      加算回数
+!! @param [out]    flop      flop count
+!! @note fb_average_v/s, calc_rms_v/s, calc_reynolds_stress, calc_production_rate,
+!!       calc_dissipation_rate, calc_turb_transport_rate, calc_vel_pregrad_term を順に呼ぶのと同じ結果を与える．
+!!       k方向をkblk枚ずつのブロックに分け，点ごとの更新（平均値，変動値，R）をステンシル処理より
+!!       1枚先行させるので，ステンシル処理はキャッシュ上にあるブロックのデータを参照する．
+!!       Rはブロックの前後の面しか参照しないので，nr枚のk面を循環して使う．
+!!       sw_pk=1の場合，テンソルの時間平均は持たず，averaging_xz_planeと同じ範囲(i=2..ix-1, k=2..kx-1)の
+!!       面内総和をprofに返す．面の和はjごとに1スレッドが順に取るので結果はスレッド数に依存しない
+!<
+subroutine calc_turb_statistics_fused (v_ave, ap, rms_v, rmsmean_v, rms_p, rmsmean_p, &
+                                       R, nr, R_ave, P_ave, E_ave, T_ave, PI_ave, prof, &
+                                       sz, dh, g, nu, v, p, bid, bp, sw_v, sw_p, sw_pk, nadd, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  i, j, k, ix, jx, kx, g, idx, bpx, m, nr, kblk
+integer                                                   ::  sw_v, sw_p, sw_pk, kb, ke, ks1, ke1, kdone
+integer                                                   ::  kr, krb, krt
+integer, dimension(3)                                     ::  sz
+real, dimension(3)                                        ::  dh
+real                                                      ::  nadd, val1, val2, nu
+real                                                      ::  rx, ry, rz, qx, qy, qz, tmp
+real                                                      ::  actv, b_e1, b_w1, b_n1, b_s1, b_t1, b_b1
+real                                                      ::  v1p, v2p, v3p, t1, t2, t3
+real                                                      ::  Up0, Ue1, Uw1, Us1, Un1, Ub1, Ut1
+real                                                      ::  Vp0, Ve1, Vw1, Vs1, Vn1, Vb1, Vt1
+real                                                      ::  Wp0, We1, Ww1, Ws1, Wn1, Wb1, Wt1
+real                                                      ::  u_p0, u_e1, u_w1, u_s1, u_n1, u_b1, u_t1
+real                                                      ::  v_p0, v_e1, v_w1, v_s1, v_n1, v_b1, v_t1
+real                                                      ::  w_p0, w_e1, w_w1, w_s1, w_n1, w_b1, w_t1
+real                                                      ::  p0, pe1, pn1, pt1
+real                                                      ::  g11, g12, g13, g21, g22, g23, g31, g32, g33
+real                                                      ::  R11, R12, R13, R22, R23, R33
+real                                                      ::  P11_1, P12_1, P13_1, P22_1, P23_1, P33_1, P21_1, P31_1, P32_1
+real                                                      ::  d1, d2, d3, rc, re, rw, rn, rs, rt, rb
+real, dimension(6)                                        ::  pp, ee, tt, pi
+logical                                                   ::  inner
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g, 3) ::  v, v_ave, rms_v, rmsmean_v
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  p, ap, rms_p, rmsmean_p
+real, dimension(6, 1-g:sz(1)+g, 1-g:sz(2)+g, 0:nr-1)      ::  R
+real, dimension(6, 1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  R_ave, P_ave, E_ave, T_ave, PI_ave
+double precision, dimension(30, sz(2))                    ::  prof
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bid, bp
+double precision                                          ::  flop
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+kblk = nr - g - 2
+
+! 中心差分 (生成・散逸・拡散) と片側差分 (速度圧力勾配) の係数
+rx = 1.0 / (2.0*dh(1))
+ry = 1.0 / (2.0*dh(2))
+rz = 1.0 / (2.0*dh(3))
+qx = 1.0 / dh(1)
+qy = 1.0 / dh(2)
+qz = 1.0 / dh(3)
+
+val2 = 1.0/nadd
+val1 = 1.0 - val2
+
+! 平均値 12, R 27, rms_v 12, rms_p 4, 収支項 465
+flop = flop + dble(ix)*dble(jx)*dble(kx)*(12.0d0 + 465.0d0) &
+            + dble(ix+2*g) * dble(jx+2*g) * dble(kx+2*g) * 27.0d0 + 69.0d0
+if ( sw_v == 1 ) flop = flop + dble(ix+2*g) * dble(jx+2*g) * dble(kx+2*g) * 12.0d0
+if ( sw_p == 1 ) flop = flop + dble(ix+2*g) * dble(jx+2*g) * dble(kx+2*g) * 4.0d0
+
+if ( sw_pk == 1 ) prof = 0.0d0
+
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(kb, ke, ks1, ke1, kdone, kr, krb, krt, inner, idx, bpx, actv, tmp) &
+!$OMP PRIVATE(b_e1, b_w1, b_n1, b_s1, b_t1, b_b1) &
+!$OMP PRIVATE(v1p, v2p, v3p, t1, t2, t3) &
+!$OMP PRIVATE(Up0, Ue1, Uw1, Us1, Un1, Ub1, Ut1) &
+!$OMP PRIVATE(Vp0, Ve1, Vw1, Vs1, Vn1, Vb1, Vt1) &
+!$OMP PRIVATE(Wp0, We1, Ww1, Ws1, Wn1, Wb1, Wt1) &
+!$OMP PRIVATE(u_p0, u_e1, u_w1, u_s1, u_n1, u_b1, u_t1) &
+!$OMP PRIVATE(v_p0, v_e1, v_w1, v_s1, v_n1, v_b1, v_t1) &
+!$OMP PRIVATE(w_p0, w_e1, w_w1, w_s1, w_n1, w_b1, w_t1) &
+!$OMP PRIVATE(p0, pe1, pn1, pt1) &
+!$OMP PRIVATE(g11, g12, g13, g21, g22, g23, g31, g32, g33) &
+!$OMP PRIVATE(R11, R12, R13, R22, R23, R33) &
+!$OMP PRIVATE(P11_1, P12_1, P13_1, P22_1, P23_1, P33_1, P21_1, P31_1, P32_1) &
+!$OMP PRIVATE(d1, d2, d3, m, rc, re, rw, rn, rs, rt, rb, pp, ee, tt, pi) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, g, nr, kblk, rx, ry, rz, qx, qy, qz, nu, val1, val2, sw_v, sw_p, sw_pk)
+
+! 点ごとの更新が終わった面（全スレッドで同じ値を持つ）
+kdone = -g
+
+do kb = 1, kx, kblk
+ke = min(kb+kblk-1, kx)
+
+! (1) 点ごとの更新 >> ステンシル処理で参照するk+1面まで
+ks1 = kdone + 1
+ke1 = ke + 1
+if ( ke == kx ) ke1 = kx + g
+
+!$OMP DO SCHEDULE(static)
+do j = 1-g, jx+g
+do k = ks1, ke1
+kr = mod(k+g, nr)
+
+! 時間平均値は計算領域内部のみ
+if ( (k >= 1) .and. (k <= kx) .and. (j >= 1) .and. (j <= jx) ) then
+do i = 1, ix
+v_ave(i, j, k, 1) = val1 * v_ave(i, j, k, 1) + val2 * v(i, j, k, 1)
+v_ave(i, j, k, 2) = val1 * v_ave(i, j, k, 2) + val2 * v(i, j, k, 2)
+v_ave(i, j, k, 3) = val1 * v_ave(i, j, k, 3) + val2 * v(i, j, k, 3)
+ap(i, j, k)       = val1 * ap(i, j, k)       + val2 * p(i, j, k)
+end do
+endif
+
+! レイノルズ応力テンソル (瞬時値)
+do i = 1-g, ix+g
+v1p = v(i, j, k, 1) - v_ave(i, j, k, 1)
+v2p = v(i, j, k, 2) - v_ave(i, j, k, 2)
+v3p = v(i, j, k, 3) - v_ave(i, j, k, 3)
+
+R(1, i, j, kr) = v1p * v1p
+R(2, i, j, kr) = v1p * v2p
+R(3, i, j, kr) = v1p * v3p
+R(4, i, j, kr) = v2p * v2p
+R(5, i, j, kr) = v2p * v3p
+R(6, i, j, kr) = v3p * v3p
+end do
+
+! レイノルズ応力テンソル (時間平均値)
+if ( sw_pk == 0 ) then
+do i = 1-g, ix+g
+R_ave(1, i, j, k) = val1 * R_ave(1, i, j, k) + val2 * R(1, i, j, kr)
+R_ave(2, i, j, k) = val1 * R_ave(2, i, j, k) + val2 * R(2, i, j, kr)
+R_ave(3, i, j, k) = val1 * R_ave(3, i, j, k) + val2 * R(3, i, j, kr)
+R_ave(4, i, j, k) = val1 * R_ave(4, i, j, k) + val2 * R(4, i, j, kr)
+R_ave(5, i, j, k) = val1 * R_ave(5, i, j, k) + val2 * R(5, i, j, kr)
+R_ave(6, i, j, k) = val1 * R_ave(6, i, j, k) + val2 * R(6, i, j, kr)
+end do
+else if ( (k >= 2) .and. (k <= kx-1) .and. (j >= 1) .and. (j <= jx) ) then
+do i = 2, ix-1
+do m = 1, 6
+prof(m, j) = prof(m, j) + dble(R(m, i, j, kr))
+end do
+end do
+endif
+
+if ( sw_v == 1 ) then
+do i = 1-g, ix+g
+d1 = abs( v(i, j, k, 1) - v_ave(i, j, k, 1) )
+d2 = abs( v(i, j, k, 2) - v_ave(i, j, k, 2) )
+d3 = abs( v(i, j, k, 3) - v_ave(i, j, k, 3) )
+rms_v(i, j, k, 1) = d1
+rms_v(i, j, k, 2) = d2
+rms_v(i, j, k, 3) = d3
+rmsmean_v(i, j, k, 1) = val1 * rmsmean_v(i, j, k, 1) + val2 * d1
+rmsmean_v(i, j, k, 2) = val1 * rmsmean_v(i, j, k, 2) + val2 * d2
+rmsmean_v(i, j, k, 3) = val1 * rmsmean_v(i, j, k, 3) + val2 * d3
+end do
+endif
+
+if ( sw_p == 1 ) then
+do i = 1-g, ix+g
+d1 = abs( p(i, j, k) - ap(i, j, k) )
+rms_p(i, j, k) = d1
+rmsmean_p(i, j, k) = val1 * rmsmean_p(i, j, k) + val2 * d1
+end do
+endif
+
+end do
+end do
+!$OMP END DO
+
+kdone = ke1
+
+
+! (2) ステンシル処理 >> 生成項，散逸項，乱流拡散項，速度圧力勾配相関項
+!$OMP DO SCHEDULE(static)
+do j = 1, jx
+do k = kb, ke
+krb = mod(k-1+g, nr)
+kr  = mod(k  +g, nr)
+krt = mod(k+1+g, nr)
+inner = (sw_pk == 1) .and. (k >= 2) .and. (k <= kx-1)
+
+do i = 1, ix
+
+idx = bid(i,j,k)
+bpx = bp(i,j,k)
+
+! セル状態 (0-solid / 1-fluid)
+actv = real(ibits(idx, State, 1))
+
+b_w1 = 1.0
+b_e1 = 1.0
+b_s1 = 1.0
+b_n1 = 1.0
+b_b1 = 1.0
+b_t1 = 1.0
+if ( ibits(idx, bc_face_W, bitw_5) /= 0 ) b_w1 = 0.0
+if ( ibits(idx, bc_face_E, bitw_5) /= 0 ) b_e1 = 0.0
+if ( ibits(idx, bc_face_S, bitw_5) /= 0 ) b_s1 = 0.0
+if ( ibits(idx, bc_face_N, bitw_5) /= 0 ) b_n1 = 0.0
+if ( ibits(idx, bc_face_B, bitw_5) /= 0 ) b_b1 = 0.0
+if ( ibits(idx, bc_face_T, bitw_5) /= 0 ) b_t1 = 0.0
+
+! 平均速度
+Ub1 = v_ave(i  ,j  ,k-1, 1)
+Us1 = v_ave(i  ,j-1,k  , 1)
+Uw1 = v_ave(i-1,j  ,k  , 1)
+Up0 = v_ave(i  ,j  ,k  , 1)
+Ue1 = v_ave(i+1,j  ,k  , 1)
+Un1 = v_ave(i  ,j+1,k  , 1)
+Ut1 = v_ave(i  ,j  ,k+1, 1)
+
+Vb1 = v_ave(i  ,j  ,k-1, 2)
+Vs1 = v_ave(i  ,j-1,k  , 2)
+Vw1 = v_ave(i-1,j  ,k  , 2)
+Vp0 = v_ave(i  ,j  ,k  , 2)
+Ve1 = v_ave(i+1,j  ,k  , 2)
+Vn1 = v_ave(i  ,j+1,k  , 2)
+Vt1 = v_ave(i  ,j  ,k+1, 2)
+
+Wb1 = v_ave(i  ,j  ,k-1, 3)
+Ws1 = v_ave(i  ,j-1,k  , 3)
+Ww1 = v_ave(i-1,j  ,k  , 3)
+Wp0 = v_ave(i  ,j  ,k  , 3)
+We1 = v_ave(i+1,j  ,k  , 3)
+Wn1 = v_ave(i  ,j+1,k  , 3)
+Wt1 = v_ave(i  ,j  ,k+1, 3)
+
+! 変動速度
+u_b1 = v(i  ,j  ,k-1, 1) - Ub1
+u_s1 = v(i  ,j-1,k  , 1) - Us1
+u_w1 = v(i-1,j  ,k  , 1) - Uw1
+u_p0 = v(i  ,j  ,k  , 1) - Up0
+u_e1 = v(i+1,j  ,k  , 1) - Ue1
+u_n1 = v(i  ,j+1,k  , 1) - Un1
+u_t1 = v(i  ,j  ,k+1, 1) - Ut1
+
+v_b1 = v(i  ,j  ,k-1, 2) - Vb1
+v_s1 = v(i  ,j-1,k  , 2) - Vs1
+v_w1 = v(i-1,j  ,k  , 2) - Vw1
+v_p0 = v(i  ,j  ,k  , 2) - Vp0
+v_e1 = v(i+1,j  ,k  , 2) - Ve1
+v_n1 = v(i  ,j+1,k  , 2) - Vn1
+v_t1 = v(i  ,j  ,k+1, 2) - Vt1
+
+w_b1 = v(i  ,j  ,k-1, 3) - Wb1
+w_s1 = v(i  ,j-1,k  , 3) - Ws1
+w_w1 = v(i-1,j  ,k  , 3) - Ww1
+w_p0 = v(i  ,j  ,k  , 3) - Wp0
+w_e1 = v(i+1,j  ,k  , 3) - We1
+w_n1 = v(i  ,j+1,k  , 3) - Wn1
+w_t1 = v(i  ,j  ,k+1, 3) - Wt1
+
+v1p = u_p0
+v2p = v_p0
+v3p = w_p0
+
+! 壁面の場合の参照速度の修正
+if ( b_e1 == 0.0 ) then
+Ue1 = -Up0
+Ve1 = -Vp0
+We1 = -Wp0
+u_e1 = -u_p0
+v_e1 = -v_p0
+w_e1 = -w_p0
+endif
+
+if ( b_w1 == 0.0 ) then
+Uw1 = -Up0
+Vw1 = -Vp0
+Ww1 = -Wp0
+u_w1 = -u_p0
+v_w1 = -v_p0
+w_w1 = -w_p0
+endif
+
+if ( b_n1 == 0.0 ) then
+Un1 = -Up0
+Vn1 = -Vp0
+Wn1 = -Wp0
+u_n1 = -u_p0
+v_n1 = -v_p0
+w_n1 = -w_p0
+endif
+
+if ( b_s1 == 0.0 ) then
+Us1 = -Up0
+Vs1 = -Vp0
+Ws1 = -Wp0
+u_s1 = -u_p0
+v_s1 = -v_p0
+w_s1 = -w_p0
+endif
+
+if ( b_t1 == 0.0 ) then
+Ut1 = -Up0
+Vt1 = -Vp0
+Wt1 = -Wp0
+u_t1 = -u_p0
+v_t1 = -v_p0
+w_t1 = -w_p0
+endif
+
+if ( b_b1 == 0.0 ) then
+Ub1 = -Up0
+Vb1 = -Vp0
+Wb1 = -Wp0
+u_b1 = -u_p0
+v_b1 = -v_p0
+w_b1 = -w_p0
+endif
+
+
+! (a) 生成項 : 平均速度勾配テンソルとRの積
+g11 = rx * ( Ue1 - Uw1 ) * actv
+g12 = rx * ( Ve1 - Vw1 ) * actv
+g13 = rx * ( We1 - Ww1 ) * actv
+g21 = ry * ( Un1 - Us1 ) * actv
+g22 = ry * ( Vn1 - Vs1 ) * actv
+g23 = ry * ( Wn1 - Ws1 ) * actv
+g31 = rz * ( Ut1 - Ub1 ) * actv
+g32 = rz * ( Vt1 - Vb1 ) * actv
+g33 = rz * ( Wt1 - Wb1 ) * actv
+
+R11 = R(1, i, j, kr)
+R12 = R(2, i, j, kr)
+R13 = R(3, i, j, kr)
+R22 = R(4, i, j, kr)
+R23 = R(5, i, j, kr)
+R33 = R(6, i, j, kr)
+
+P11_1 = R11*g11 + R12*g21 + R13*g31
+P12_1 = R11*g12 + R12*g22 + R13*g32
+P13_1 = R11*g13 + R12*g23 + R13*g33
+P21_1 = R12*g11 + R22*g21 + R23*g31
+P22_1 = R12*g12 + R22*g22 + R23*g32
+P23_1 = R12*g13 + R22*g23 + R23*g33
+P31_1 = R13*g11 + R23*g21 + R33*g31
+P32_1 = R13*g12 + R23*g22 + R33*g32
+P33_1 = R13*g13 + R23*g23 + R33*g33
+
+pp(1) = -( P11_1 + P11_1 ) * actv
+pp(2) = -( P12_1 + P21_1 ) * actv
+pp(3) = -( P13_1 + P31_1 ) * actv
+pp(4) = -( P22_1 + P22_1 ) * actv
+pp(5) = -( P23_1 + P32_1 ) * actv
+pp(6) = -( P33_1 + P33_1 ) * actv
+
+
+! (b) 散逸項 : 速度変動勾配テンソル
+g11 = rx * ( u_e1 - u_w1 ) * actv
+g12 = rx * ( v_e1 - v_w1 ) * actv
+g13 = rx * ( w_e1 - w_w1 ) * actv
+g21 = ry * ( u_n1 - u_s1 ) * actv
+g22 = ry * ( v_n1 - v_s1 ) * actv
+g23 = ry * ( w_n1 - w_s1 ) * actv
+g31 = rz * ( u_t1 - u_b1 ) * actv
+g32 = rz * ( v_t1 - v_b1 ) * actv
+g33 = rz * ( w_t1 - w_b1 ) * actv
+
+tmp = 2.0 * nu * actv
+
+ee(1) = tmp * ( g11*g11 + g21*g21 + g31*g31 )
+ee(2) = tmp * ( g11*g12 + g21*g22 + g31*g32 )
+ee(3) = tmp * ( g11*g13 + g21*g23 + g31*g33 )
+ee(4) = tmp * ( g12*g12 + g22*g22 + g32*g32 )
+ee(5) = tmp * ( g12*g13 + g22*g23 + g32*g33 )
+ee(6) = tmp * ( g13*g13 + g23*g23 + g33*g33 )
+
+
+! (c) 乱流拡散項 : 壁面では隣接値を中心値の符号を反転した値に置き換える
+t1 = v1p * rx
+t2 = v2p * ry
+t3 = v3p * rz
+
+do m = 1, 6
+rc = R(m, i, j, kr)
+re = b_e1 * R(m, i+1, j  , kr ) - (1.0 - b_e1) * rc
+rw = b_w1 * R(m, i-1, j  , kr ) - (1.0 - b_w1) * rc
+rn = b_n1 * R(m, i  , j+1, kr ) - (1.0 - b_n1) * rc
+rs = b_s1 * R(m, i  , j-1, kr ) - (1.0 - b_s1) * rc
+rt = b_t1 * R(m, i  , j  , krt) - (1.0 - b_t1) * rc
+rb = b_b1 * R(m, i  , j  , krb) - (1.0 - b_b1) * rc
+tt(m) = -( t1 * (re - rw) + t2 * (rn - rs) + t3 * (rt - rb) ) * actv
+end do
+
+
+! (d) 速度圧力勾配相関項 : 変動圧力の片側差分
+p0  = p(i,   j,   k  ) - ap(i,   j,   k  )
+pe1 = p(i+1, j,   k  ) - ap(i+1, j,   k  )
+pn1 = p(i,   j+1, k  ) - ap(i,   j+1, k  )
+pt1 = p(i,   j,   k+1) - ap(i,   j,   k+1)
+
+if ( ibits(bpx, bc_n_E, 1) == 0 ) pe1 = p0
+if ( ibits(bpx, bc_n_N, 1) == 0 ) pn1 = p0
+if ( ibits(bpx, bc_n_T, 1) == 0 ) pt1 = p0
+if ( ibits(bpx, bc_d_E, 1) == 0 ) pe1 = -p0
+if ( ibits(bpx, bc_d_N, 1) == 0 ) pn1 = -p0
+if ( ibits(bpx, bc_d_T, 1) == 0 ) pt1 = -p0
+
+! セル状態はBCindex Pから
+actv = real(ibits(bpx, State, 1))
+d1 = qx * ( pe1 - p0 ) * actv
+d2 = qy * ( pn1 - p0 ) * actv
+d3 = qz * ( pt1 - p0 ) * actv
+
+pi(1) = -( v1p*d1 + v1p*d1 ) * actv
+pi(2) = -( v1p*d2 + v2p*d1 ) * actv
+pi(3) = -( v1p*d3 + v3p*d1 ) * actv
+pi(4) = -( v2p*d2 + v2p*d2 ) * actv
+pi(5) = -( v2p*d3 + v3p*d2 ) * actv
+pi(6) = -( v3p*d3 + v3p*d3 ) * actv
+
+
+! 時間平均値，または面内の総和
+if ( sw_pk == 0 ) then
+do m = 1, 6
+P_ave(m, i, j, k)  = val1 * P_ave(m, i, j, k)  + val2 * pp(m)
+E_ave(m, i, j, k)  = val1 * E_ave(m, i, j, k)  + val2 * ee(m)
+T_ave(m, i, j, k)  = val1 * T_ave(m, i, j, k)  + val2 * tt(m)
+PI_ave(m, i, j, k) = val1 * PI_ave(m, i, j, k) + val2 * pi(m)
+end do
+else if ( inner .and. (i >= 2) .and. (i <= ix-1) ) then
+do m = 1, 6
+prof(m+ 6, j) = prof(m+ 6, j) + dble(pp(m))
+prof(m+12, j) = prof(m+12, j) + dble(ee(m))
+prof(m+18, j) = prof(m+18, j) + dble(tt(m))
+prof(m+24, j) = prof(m+24, j) + dble(pi(m))
+end do
+endif
+
+end do
+end do
+end do
+!$OMP END DO
+
+end do
+
+!$OMP END PARALLEL
+
+return
+end subroutine calc_turb_statistics_fused
+!> ********************************************************************
+
+
+!> ********************************************************************
+!! @brief x-z面平均プロファイルの時間平均（補償付きWelford更新）
+!! @param [in,out] pm    時間平均値
+!! @param [in,out] pc    補償項
+!! @param [in]     ps    面内の総和 (calc_turb_statistics_fusedのprof)
+!! @param [in]     n     要素数
+!! @param [in]     scale 面内の総和から平均への係数 1/((ix-2)(kx-2))
+!! @param [in]     nadd  加算回数
+!! @param [out]    flop  flop count
+!! @note m_n = m_{n-1} + (x_n - m_{n-1})/n の増分をKahanの方法で補償しながら倍精度で加える．
+!!       増分の丸め誤差は補償項に残るので，時間平均の誤差は加算回数nによらず
+!!       |m - m_exact| <= 2 u max|x| + n u^2 max|x| (u=2^{-53}) で抑えられる．
+!!       面内総和の誤差は (ix-2)(kx-2) u max|x| 以下であり，いずれも瞬時値自体の丸め誤差
+!!       (単精度で2^{-24}) より十分小さい．セル毎の単精度の時間平均は n 2^{-25} 程度まで誤差が増え得る
+!<
+subroutine stat_profile_update (pm, pc, ps, n, scale, nadd, flop)
+implicit none
+integer                                                   ::  l, n
+double precision, dimension(n)                            ::  pm, pc, ps
+double precision                                          ::  scale, val2, x, y, t
+real                                                      ::  nadd
+double precision                                          ::  flop
+
+val2 = 1.0d0 / dble(nadd)
+
+flop = flop + dble(n) * 7.0d0 + 8.0d0
+
+do l = 1, n
+x = ps(l) * scale
+y = (x - pm(l)) * val2 - pc(l)
+t = pm(l) + y
+pc(l) = (t - pm(l)) - y
+pm(l) = t
+end do
+
+return
+end subroutine stat_profile_update
+
+
 !********************************************************************
-subroutine averaging_xz_plane(vmean, rmsmean, Rmean, Pmean, Emean, Tmean, PImean, sz, g, v_ave, rms_ave, R_ave, P_ave, E_ave, T_ave, PI_ave, flop)
+subroutine averaging_xz_plane(vmean, rmsmean, Rmean, Pmean, Emean, Tmean, PImean, sz, g, v_ave, rms_ave, R_ave, P_ave, E_ave, T_ave, PI_ave, sw_pk, flop)
 integer, dimension(3)                                     :: sz
-integer                                                   :: ix, jx, kx, i, j, k, g, d
+integer                                                   :: ix, jx, kx, i, j, k, g, d, sw_pk
 real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g, 3) :: v_ave, rms_ave
 real, dimension(6, 1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) :: R_ave, P_ave, E_ave, T_ave, PI_ave
 real, dimension(3, 1:sz(2))                               :: vmean, rmsmean
@@ -2545,6 +3117,9 @@ tmp = 1.0/((ix-2)*(kx-2))
 flop = flop + 3.0d0 * dble(jx) * dble(kx-2)*dble(ix-2)*4.0d0 + 9.0d0 &
      + 6.0d0 * dble(jx) * dble(kx-2)*dble(ix-2)*10.0d0
 
+! テンソルを面平均プロファイルとして積算している場合は速度と乱流強度のみ
+if ( sw_pk == 1 ) flop = flop - 6.0d0 * dble(jx) * dble(kx-2)*dble(ix-2)*10.0d0
+
 !$OMP PARALLEL &
 !$OMP FIRSTPRIVATE(ix, jx, kx)
 !$OMP DO SCHEDULE(static)
@@ -2564,6 +3139,8 @@ end do
 !$OMP END PARALLEL
 
 
+if ( sw_pk == 1 ) return
+
 !$OMP PARALLEL &
 !$OMP FIRSTPRIVATE(ix, jx, kx)
 !$OMP DO SCHEDULE(static)
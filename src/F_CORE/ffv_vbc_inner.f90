@@ -232,24 +232,24 @@ end subroutine perturb_u_z
 !! @param [out] wv   疑似ベクトルの空間項の評価値
 !! @param [in]  sz   配列長
 !! @param [in]  g    ガイドセル長
-!! @param [in]  st   ループの開始インデクス
-!! @param [in]  ed   ループの終了インデクス
+!! @param [in]  nl   セルリストの要素数
+!! @param [in]  lst  セルリスト (i, j, k, 面フラグ)
 !! @param [in]  dh   格子幅
 !! @param [in]  rei  Reynolds数の逆数
 !! @param [in]  v    セルセンター速度ベクトル（u^n）
 !! @param [in]  bv   BCindex C
-!! @param [in]  odr  内部境界処理時の速度境界条件のエントリ
 !! @param [in]  vec  指定する速度ベクトル
 !! @param [out] flop 浮動小数点演算数
 !! @note vecには，流出条件のとき対流流出速度
 !! @todo 内部と外部の分離 do loopの内側に条件分岐を入れているので修正
 !! @todo 流出境界はローカルの流束となるように変更する（外部境界参照）
 !<
-subroutine pvec_ibc_oflow (wv, sz, g, st, ed, dh, rei, v, bv, odr, vec, flop)
+subroutine pvec_ibc_oflow (wv, sz, g, nl, lst, dh, rei, v, bv, vec, flop)
 implicit none
 include 'ffv_f_params.h'
-integer                                                   ::  i, j, k, g, bvx, odr, is, ie, js, je, ks, ke
-integer, dimension(3)                                     ::  sz, st, ed
+integer                                                   ::  i, j, k, g, bvx, nl, l, fcx
+integer, dimension(3)                                     ::  sz
+integer, dimension(4, nl)                                 ::  lst
 double precision                                          ::  flop
 real                                                      ::  Up0, Ue1, Uw1, Us1, Un1, Ub1, Ut1
 real                                                      ::  Vp0, Ve1, Vw1, Vs1, Vn1, Vb1, Vt1
@@ -276,19 +276,13 @@ u_bc = vec(1)
 v_bc = vec(2)
 w_bc = vec(3)
 
-is = st(1)
-ie = ed(1)
-js = st(2)
-je = ed(2)
-ks = st(3)
-ke = ed(3)
-
 flop = flop + 30.0d0 ! DP 15 flops
 
 m = 0.0
 
 !$OMP PARALLEL REDUCTION(+:m) &
-!$OMP FIRSTPRIVATE(is, ie, js, je, ks, ke, u_bc, v_bc, w_bc, odr) &
+!$OMP PRIVATE(i, j, k, fcx) &
+!$OMP FIRSTPRIVATE(u_bc, v_bc, w_bc) &
 !$OMP FIRSTPRIVATE(rx, ry, rz, dx2, dy2, dz2) &
 !$OMP PRIVATE(bvx, cnv_u, cnv_v, cnv_w, cr, cl) &
 !$OMP PRIVATE(Up0, Ue1, Uw1, Us1, Un1, Ub1, Ut1) &
@@ -300,9 +294,11 @@ m = 0.0
 
 !$OMP DO SCHEDULE(static)
 
-    do k=ks,ke
-    do j=js,je
-    do i=is,ie
+    do l=1,nl
+      i   = lst(1,l)
+      j   = lst(2,l)
+      k   = lst(3,l)
+      fcx = lst(4,l)
       bvx = bv(i,j,k)
 
       if ( 0 /= iand(bvx, bc_mask30) ) then ! 6面のうちのどれか速度境界フラグが立っている場合
@@ -341,12 +337,12 @@ m = 0.0
         c_s = 0.0
         c_t = 0.0
         c_b = 0.0
-        if ( ibits(bvx, bc_face_E, bitw_5) == odr ) c_e = 1.0
-        if ( ibits(bvx, bc_face_W, bitw_5) == odr ) c_w = 1.0
-        if ( ibits(bvx, bc_face_N, bitw_5) == odr ) c_n = 1.0
-        if ( ibits(bvx, bc_face_S, bitw_5) == odr ) c_s = 1.0
-        if ( ibits(bvx, bc_face_T, bitw_5) == odr ) c_t = 1.0
-        if ( ibits(bvx, bc_face_B, bitw_5) == odr ) c_b = 1.0
+        if ( btest(fcx, X_plus) ) c_e = 1.0
+        if ( btest(fcx, X_minus) ) c_w = 1.0
+        if ( btest(fcx, Y_plus) ) c_n = 1.0
+        if ( btest(fcx, Y_minus) ) c_s = 1.0
+        if ( btest(fcx, Z_plus) ) c_t = 1.0
+        if ( btest(fcx, Z_minus) ) c_b = 1.0
 			
         ! X方向 ---------------------------------------
         if ( c_w == 1.0 ) then
@@ -457,8 +453,6 @@ m = 0.0
         m = m + 1.0
       endif
     end do
-    end do
-    end do
     
 !$OMP END DO
 !$OMP END PARALLEL
@@ -476,24 +470,24 @@ end subroutine pvec_ibc_oflow
 !! @param [out] wv   疑似ベクトルの空間項の評価値
 !! @param [in]  sz   配列長
 !! @param [in]  g    ガイドセル長
-!! @param [in]  st   ループの開始インデクス
-!! @param [in]  ed   ループの終了インデクス
+!! @param [in]  nl   セルリストの要素数
+!! @param [in]  lst  セルリスト (i, j, k, 面フラグ)
 !! @param [in]  dh   格子幅
 !! @param [in]  v00  参照速度
 !! @param [in]  rei  Reynolds数の逆数
 !! @param [in]  v    セルセンター速度ベクトル（u^n）
 !! @param [in]  bv   BCindex C
-!! @param [in]  odr  内部境界処理時の速度境界条件のエントリ
 !! @param [in]  vec  指定する速度ベクトル
 !! @param [out] flop 浮動小数点演算数
 !! @note vecには，流入条件のとき指定速度，流出条件のとき対流流出速度，カット位置に関わらず指定速度で流束を計算
 !! @todo 流出境界はローカルの流束となるように変更する（外部境界参照）
 !<
-subroutine pvec_ibc_specv_fvm (wv, sz, g, st, ed, dh, v00, rei, v, bv, odr, vec, flop)
+subroutine pvec_ibc_specv_fvm (wv, sz, g, nl, lst, dh, v00, rei, v, bv, vec, flop)
 implicit none
 include 'ffv_f_params.h'
-integer                                                     ::  i, j, k, g, bvx, odr, is, ie, js, je, ks, ke
-integer, dimension(3)                                       ::  sz, st, ed
+integer                                                     ::  i, j, k, g, bvx, nl, l, fcx
+integer, dimension(3)                                       ::  sz
+integer, dimension(4, nl)                                   ::  lst
 double precision                                            ::  flop
 real                                                        ::  Up0, Ue1, Uw1, Us1, Un1, Ub1, Ut1
 real                                                        ::  Vp0, Ve1, Vw1, Vs1, Vn1, Vb1, Vt1
@@ -509,13 +503,6 @@ integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)   ::  bv
 real, dimension(0:3)                                        ::  v00
 real, dimension(3)                                          ::  vec, dh
 
-is = st(1)
-ie = ed(1)
-js = st(2)
-je = ed(2)
-ks = st(3)
-ke = ed(3)
-
 rx = 1.0/dh(1)
 ry = 1.0/dh(2)
 rz = 1.0/dh(3)
@@ -545,9 +532,10 @@ m2 = 0.0
 flop = flop + 33.0d0 ! DP 18 flop
 
 !$OMP PARALLEL &
+!$OMP PRIVATE(i, j, k, fcx) &
 !$OMP REDUCTION(+:m1) &
 !$OMP REDUCTION(+:m2) &
-!$OMP FIRSTPRIVATE(is, ie, js, je, ks, ke, u_bc, v_bc, w_bc, u_bc_ref, v_bc_ref, w_bc_ref, odr) &
+!$OMP FIRSTPRIVATE(u_bc, v_bc, w_bc, u_bc_ref, v_bc_ref, w_bc_ref) &
 !$OMP FIRSTPRIVATE(rx, ry, rz, dx2, dy2, dz2) &
 !$OMP PRIVATE(bvx, cnv_u, cnv_v, cnv_w, EX, EY, EZ, cr, cl, acr, acl) &
 !$OMP PRIVATE(Up0, Ue1, Uw1, Us1, Un1, Ub1, Ut1) &
@@ -558,9 +546,11 @@ flop = flop + 33.0d0 ! DP 18 flop
 
 !$OMP DO SCHEDULE(static)
     
-    do k=ks,ke
-    do j=js,je
-    do i=is,ie
+    do l=1,nl
+      i   = lst(1,l)
+      j   = lst(2,l)
+      k   = lst(3,l)
+      fcx = lst(4,l)
       bvx = bv(i,j,k)
 
       if ( 0 /= iand(bvx, bc_mask30) ) then ! 6面のうちのどれか速度境界フラグが立っている場合
@@ -599,12 +589,12 @@ flop = flop + 33.0d0 ! DP 18 flop
         c_s = 0.0
         c_t = 0.0
         c_b = 0.0
-        if ( ibits(bvx, bc_face_E, bitw_5) == odr ) c_e = 1.0
-        if ( ibits(bvx, bc_face_W, bitw_5) == odr ) c_w = 1.0
-        if ( ibits(bvx, bc_face_N, bitw_5) == odr ) c_n = 1.0
-        if ( ibits(bvx, bc_face_S, bitw_5) == odr ) c_s = 1.0
-        if ( ibits(bvx, bc_face_T, bitw_5) == odr ) c_t = 1.0
-        if ( ibits(bvx, bc_face_B, bitw_5) == odr ) c_b = 1.0
+        if ( btest(fcx, X_plus) ) c_e = 1.0
+        if ( btest(fcx, X_minus) ) c_w = 1.0
+        if ( btest(fcx, Y_plus) ) c_n = 1.0
+        if ( btest(fcx, Y_minus) ) c_s = 1.0
+        if ( btest(fcx, Z_plus) ) c_t = 1.0
+        if ( btest(fcx, Z_minus) ) c_b = 1.0
 
       
         ! X方向 ---------------------------------------
@@ -723,8 +713,6 @@ flop = flop + 33.0d0 ! DP 18 flop
         
       endif
     end do
-    end do
-    end do
 !$OMP END DO
 !$OMP END PARALLEL
 
@@ -742,14 +730,13 @@ flop = flop + 33.0d0 ! DP 18 flop
 !! @param [out] wv   疑似ベクトルの空間項の評価値
 !! @param [in]  sz   配列長
 !! @param [in]  g    ガイドセル長
-!! @param [in]  st   ループの開始インデクス
-!! @param [in]  ed   ループの終了インデクス
+!! @param [in]  nl   セルリストの要素数
+!! @param [in]  lst  セルリスト (i, j, k, 面フラグ)
 !! @param [in]  dh   格子幅
 !! @param [in]  v00  参照速度
 !! @param [in]  rei  Reynolds数の逆数
 !! @param [in]  v    セルセンター速度ベクトル（u^n）
 !! @param [in]  bv   BCindex C
-!! @param [in]  odr  内部境界処理時の速度境界条件のエントリ
 !! @param [in]  vec  指定する速度ベクトル
 !! @param [out] flop 浮動小数点演算数
 !! @note vecには，流入条件のとき指定速度，流出条件のとき対流流出速度，カット位置に関わらず指定速度で流束を計算
@@ -759,11 +746,12 @@ flop = flop + 33.0d0 ! DP 18 flop
 !!             + ( {\frac{\partial u}{\partial x}}_R - {\frac{\partial u}{\partial x}}_L ) \frac{1}{Re h}
 !!
 !<
-subroutine pvec_ibc_specv_fdm (wv, sz, g, st, ed, dh, v00, rei, v, bv, odr, vec, flop)
+subroutine pvec_ibc_specv_fdm (wv, sz, g, nl, lst, dh, v00, rei, v, bv, vec, flop)
 implicit none
 include 'ffv_f_params.h'
-integer                                                     ::  i, j, k, g, bvx, odr, is, ie, js, je, ks, ke
-integer, dimension(3)                                       ::  sz, st, ed
+integer                                                     ::  i, j, k, g, bvx, nl, l, fcx
+integer, dimension(3)                                       ::  sz
+integer, dimension(4, nl)                                   ::  lst
 double precision                                            ::  flop
 real                                                        ::  c_e, c_w, c_n, c_s, c_t, c_b
 real                                                        ::  rei, Up, Vp, Wp, rx, ry, rz, dx2, dy2, dz2
@@ -774,13 +762,6 @@ integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)   ::  bv
 real, dimension(0:3)                                        ::  v00
 real, dimension(3)                                          ::  vec, dh
 
-is = st(1)
-ie = ed(1)
-js = st(2)
-je = ed(2)
-ks = st(3)
-ke = ed(3)
-
 rx = 1.0/dh(1)
 ry = 1.0/dh(2)
 rz = 1.0/dh(3)
@@ -810,17 +791,20 @@ m2 = 0.0
 flop = flop + 30.0d0
 
 !$OMP PARALLEL &
+!$OMP PRIVATE(i, j, k, fcx) &
 !$OMP REDUCTION(+:m2) &
-!$OMP FIRSTPRIVATE(is, ie, js, je, ks, ke, u_bc, v_bc, w_bc, u_bc_ref, v_bc_ref, w_bc_ref, odr) &
+!$OMP FIRSTPRIVATE(u_bc, v_bc, w_bc, u_bc_ref, v_bc_ref, w_bc_ref) &
 !$OMP FIRSTPRIVATE(rx, ry, rz, dx2, dy2, dz2) &
-!$OMP PRIVATE(bvx, Up, Vp, Wp, gu, gv, gw, i, j, k) &
+!$OMP PRIVATE(bvx, Up, Vp, Wp, gu, gv, gw) &
 !$OMP PRIVATE(c_e, c_w, c_n, c_s, c_t, c_b)
 
-!$OMP DO SCHEDULE(static) COLLAPSE(3)
+!$OMP DO SCHEDULE(static)
 
-do k=ks,ke
-do j=js,je
-do i=is,ie
+do l=1,nl
+i   = lst(1,l)
+j   = lst(2,l)
+k   = lst(3,l)
+fcx = lst(4,l)
 bvx = bv(i,j,k)
 
 if ( 0 /= iand(bvx, bc_mask30) ) then ! 6面のうちのどれか速度境界フラグが立っている場合
@@ -837,12 +821,12 @@ c_n = 0.0
 c_s = 0.0
 c_t = 0.0
 c_b = 0.0
-if ( ibits(bvx, bc_face_E, bitw_5) == odr ) c_e = 1.0
-if ( ibits(bvx, bc_face_W, bitw_5) == odr ) c_w = 1.0
-if ( ibits(bvx, bc_face_N, bitw_5) == odr ) c_n = 1.0
-if ( ibits(bvx, bc_face_S, bitw_5) == odr ) c_s = 1.0
-if ( ibits(bvx, bc_face_T, bitw_5) == odr ) c_t = 1.0
-if ( ibits(bvx, bc_face_B, bitw_5) == odr ) c_b = 1.0
+if ( btest(fcx, X_plus) ) c_e = 1.0
+if ( btest(fcx, X_minus) ) c_w = 1.0
+if ( btest(fcx, Y_plus) ) c_n = 1.0
+if ( btest(fcx, Y_minus) ) c_s = 1.0
+if ( btest(fcx, Z_plus) ) c_t = 1.0
+if ( btest(fcx, Z_minus) ) c_b = 1.0
 
 
 ! X方向 ---------------------------------------
@@ -913,8 +897,6 @@ end if
 
 endif
 end do
-end do
-end do
 !$OMP END DO
 !$OMP END PARALLEL
 
@@ -929,24 +911,24 @@ end subroutine pvec_ibc_specv_fdm
 !! @param [out] wv   疑似ベクトルの空間項の評価値
 !! @param [in]  sz   配列長
 !! @param [in]  g    ガイドセル長
-!! @param [in]  st   ループの開始インデクス
-!! @param [in]  ed   ループの終了インデクス
+!! @param [in]  nl   セルリストの要素数
+!! @param [in]  lst  セルリスト (i, j, k, 面フラグ)
 !! @param [in]  dh   格子幅
 !! @param [in]  rei  Reynolds数の逆数
 !! @param [in]  v    セルセンター速度ベクトル（u^n）
 !! @param [in]  bv   BCindex C
-!! @param [in]  odr  内部境界処理時の速度境界条件のエントリ
 !! @param [in]  vec  角速度ベクトル
 !! @param [in]  org  領域基点座標
 !! @param [in]  ctr  回転中心座標
 !! @param [out] flop 浮動小数点演算数
 !! @note カット位置に関わらず指定速度で流束を計算
 !<
-subroutine pvec_ibc_sldrev_fvm (wv, sz, g, st, ed, dh, rei, v, bv, odr, vec, ctr, org, flop)
+subroutine pvec_ibc_sldrev_fvm (wv, sz, g, nl, lst, dh, rei, v, bv, vec, ctr, org, flop)
 implicit none
 include 'ffv_f_params.h'
-integer                                                     ::  i, j, k, g, bvx, odr, is, ie, js, je, ks, ke
-integer, dimension(3)                                       ::  sz, st, ed
+integer                                                     ::  i, j, k, g, bvx, nl, l, fcx
+integer, dimension(3)                                       ::  sz
+integer, dimension(4, nl)                                   ::  lst
 double precision                                            ::  flop
 real                                                        ::  Up0, Ue1, Uw1, Us1, Un1, Ub1, Ut1
 real                                                        ::  Vp0, Ve1, Vw1, Vs1, Vn1, Vb1, Vt1
@@ -962,13 +944,6 @@ integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)   ::  bv
 real, dimension(3)                                          ::  vec, org, ctr, dh
 real                                                        ::  r_u, r_v, r_w, omg_u, omg_v, omg_w, ox, oy, oz
 
-is = st(1)
-ie = ed(1)
-js = st(2)
-je = ed(2)
-ks = st(3)
-ke = ed(3)
-
 rh1= 1.0/dh(1)
 rh2= 1.0/dh(2)
 rh3= 1.0/dh(3)
@@ -999,10 +974,11 @@ m2 = 0.0
 flop = flop + 13.0d0 ! DP 18 flop
 
 !$OMP PARALLEL &
+!$OMP PRIVATE(i, j, k, fcx) &
 !$OMP REDUCTION(+:m1) &
 !$OMP REDUCTION(+:m2) &
-!$OMP FIRSTPRIVATE(is, ie, js, je, ks, ke, ox, oy, oz, rh1, rh2, rh3, dh1, dh2, dh3) &
-!$OMP FIRSTPRIVATE(odr, dx, dy, dz, cx, cy, cz, omg_u, omg_v, omg_w) &
+!$OMP FIRSTPRIVATE(ox, oy, oz, rh1, rh2, rh3, dh1, dh2, dh3) &
+!$OMP FIRSTPRIVATE(dx, dy, dz, cx, cy, cz, omg_u, omg_v, omg_w) &
 !$OMP PRIVATE(bvx, cnv_u, cnv_v, cnv_w, EX, EY, EZ, cr, cl, acr, acl) &
 !$OMP PRIVATE(Up0, Ue1, Uw1, Us1, Un1, Ub1, Ut1) &
 !$OMP PRIVATE(Vp0, Ve1, Vw1, Vs1, Vn1, Vb1, Vt1) &
@@ -1013,9 +989,11 @@ flop = flop + 13.0d0 ! DP 18 flop
 
 !$OMP DO SCHEDULE(static)
 
-do k=ks,ke
-do j=js,je
-do i=is,ie
+do l=1,nl
+i   = lst(1,l)
+j   = lst(2,l)
+k   = lst(3,l)
+fcx = lst(4,l)
 bvx = bv(i,j,k)
 
 if ( 0 /= iand(bvx, bc_mask30) ) then ! 6面のうちのどれか速度境界フラグが立っている場合
@@ -1054,12 +1032,12 @@ c_n = 0.0
 c_s = 0.0
 c_t = 0.0
 c_b = 0.0
-if ( ibits(bvx, bc_face_E, bitw_5) == odr ) c_e = 1.0
-if ( ibits(bvx, bc_face_W, bitw_5) == odr ) c_w = 1.0
-if ( ibits(bvx, bc_face_N, bitw_5) == odr ) c_n = 1.0
-if ( ibits(bvx, bc_face_S, bitw_5) == odr ) c_s = 1.0
-if ( ibits(bvx, bc_face_T, bitw_5) == odr ) c_t = 1.0
-if ( ibits(bvx, bc_face_B, bitw_5) == odr ) c_b = 1.0
+if ( btest(fcx, X_plus) ) c_e = 1.0
+if ( btest(fcx, X_minus) ) c_w = 1.0
+if ( btest(fcx, Y_plus) ) c_n = 1.0
+if ( btest(fcx, Y_minus) ) c_s = 1.0
+if ( btest(fcx, Z_plus) ) c_t = 1.0
+if ( btest(fcx, Z_minus) ) c_b = 1.0
 
 
 ! X方向 ---------------------------------------
@@ -1212,8 +1190,6 @@ m1 = m1 + 1.0
 
 endif
 end do
-end do
-end do
 !$OMP END DO
 !$OMP END PARALLEL
 
@@ -1232,19 +1208,19 @@ end subroutine pvec_ibc_sldrev_fvm
 !! @param [in]     sz   配列長
 !! @param [in]     g    ガイドセル長
 !! @param [in]     dh   格子幅
-!! @param [in]     st   ループの開始インデクス
-!! @param [in]     ed   ループの終了インデクス
+!! @param [in]     nl   セルリストの要素数
+!! @param [in]     lst  セルリスト (i, j, k, 面フラグ)
 !! @param [in]     v00  参照速度
 !! @param [in]     bv   BCindex C
-!! @param [in]     odr  速度境界条件のエントリ
 !! @param [in]     vec  指定する速度ベクトル
 !! @param [in,out] flop flop count 近似
 !<
-subroutine div_ibc_drchlt (div, sz, g, dh, st, ed, v00, bv, odr, vec, flop)
+subroutine div_ibc_drchlt (div, sz, g, dh, nl, lst, v00, bv, vec, flop)
 implicit none
 include 'ffv_f_params.h'
-integer                                                   ::  i, j, k, g, bvx, odr, is, ie, js, je, ks, ke
-integer, dimension(3)                                     ::  sz, st, ed
+integer                                                   ::  i, j, k, g, bvx, nl, l, fcx
+integer, dimension(3)                                     ::  sz
+integer, dimension(4, nl)                                 ::  lst
 double precision                                          ::  flop, m
 real                                                      ::  Ue_t, Uw_t, Vn_t, Vs_t, Wt_t, Wb_t
 real                                                      ::  u_bc_ref, v_bc_ref, w_bc_ref, rx, ry, rz
@@ -1262,25 +1238,21 @@ rx = 1.0 / dh(1)
 ry = 1.0 / dh(2)
 rz = 1.0 / dh(3)
 
-is = st(1)
-ie = ed(1)
-js = st(2)
-je = ed(2)
-ks = st(3)
-ke = ed(3)
-
-m = dble( (ie-is+1)*(je-js+1)*(ke-ks+1) )
+m = dble(nl)
 flop = flop + m*6.0d0 + 27.0d0
 
 !$OMP PARALLEL &
-!$OMP FIRSTPRIVATE(is, ie, js, je, ks, ke, u_bc_ref, v_bc_ref, w_bc_ref, odr, rx, ry, rz) &
+!$OMP PRIVATE(i, j, k, fcx) &
+!$OMP FIRSTPRIVATE(u_bc_ref, v_bc_ref, w_bc_ref, rx, ry, rz) &
 !$OMP PRIVATE(bvx, Ue_t, Uw_t, Vn_t, Vs_t, Wt_t, Wb_t)
 
 !$OMP DO SCHEDULE(static)
 
-    do k=ks,ke
-    do j=js,je
-    do i=is,ie
+    do l=1,nl
+      i   = lst(1,l)
+      j   = lst(2,l)
+      k   = lst(3,l)
+      fcx = lst(4,l)
       bvx = bv(i,j,k)
       if ( 0 /= iand(bvx, bc_mask30) ) then ! 6面のうちのどれか速度境界フラグが立っている場合
         Ue_t = 0.0
@@ -1290,19 +1262,17 @@ flop = flop + m*6.0d0 + 27.0d0
         Wt_t = 0.0
         Wb_t = 0.0
         
-        if ( ibits(bvx, bc_face_W, bitw_5) == odr ) Uw_t = u_bc_ref
-        if ( ibits(bvx, bc_face_E, bitw_5) == odr ) Ue_t = u_bc_ref
-        if ( ibits(bvx, bc_face_S, bitw_5) == odr ) Vs_t = v_bc_ref
-        if ( ibits(bvx, bc_face_N, bitw_5) == odr ) Vn_t = v_bc_ref
-        if ( ibits(bvx, bc_face_B, bitw_5) == odr ) Wb_t = w_bc_ref
-        if ( ibits(bvx, bc_face_T, bitw_5) == odr ) Wt_t = w_bc_ref
+        if ( btest(fcx, X_minus) ) Uw_t = u_bc_ref
+        if ( btest(fcx, X_plus) ) Ue_t = u_bc_ref
+        if ( btest(fcx, Y_minus) ) Vs_t = v_bc_ref
+        if ( btest(fcx, Y_plus) ) Vn_t = v_bc_ref
+        if ( btest(fcx, Z_minus) ) Wb_t = w_bc_ref
+        if ( btest(fcx, Z_plus) ) Wt_t = w_bc_ref
 
         ! VBCの面だけUe_tなどは値をもつ  対象セルは流体なのでマスク不要
         div(i,j,k) = div(i,j,k) + ( (Ue_t - Uw_t)*rx + (Vn_t - Vs_t)*ry + (Wt_t - Wb_t)*rz )
       end if
     end do
-    end do
-    end do
     
 !$OMP END DO
 !$OMP END PARALLEL
@@ -1317,22 +1287,22 @@ flop = flop + m*6.0d0 + 27.0d0
 !! @param [in,out] div  \sum{u_j}
 !! @param [in]     sz   配列長
 !! @param [in]     g    ガイドセル長
-!! @param [in]     st   ループの開始インデクス
-!! @param [in]     ed   ループの終了インデクス
+!! @param [in]     nl   セルリストの要素数
+!! @param [in]     lst  セルリスト (i, j, k, 面フラグ)
 !! @param [in]     pch  格子幅
 !! @param [in]     v00  参照速度
 !! @param [in]     bv   BCindex C
-!! @param [in]     odr  速度境界条件のエントリ
 !! @param [in]     vec  角速度ベクトル
 !! @param [in]     org  領域基点座標
 !! @param [in]     ctr  回転中心座標
 !! @param [in,out] flop flop count 近似
 !<
-subroutine div_ibc_sldrev (div, sz, g, st, ed, pch, v00, bv, odr, vec, ctr, org, flop)
+subroutine div_ibc_sldrev (div, sz, g, nl, lst, pch, v00, bv, vec, ctr, org, flop)
 implicit none
 include 'ffv_f_params.h'
-integer                                                   ::  i, j, k, g, bvx, odr, is, ie, js, je, ks, ke
-integer, dimension(3)                                     ::  sz, st, ed
+integer                                                   ::  i, j, k, g, bvx, nl, l, fcx
+integer, dimension(3)                                     ::  sz
+integer, dimension(4, nl)                                 ::  lst
 double precision                                          ::  flop, m
 real                                                      ::  Ue_t, Uw_t, Vn_t, Vs_t, Wt_t, Wb_t
 real                                                      ::  u_bc, v_bc, w_bc, cx, cy, cz, dx, dy, dz, rx, ry, rz
@@ -1362,27 +1332,23 @@ rx = 1.0/dx
 ry = 1.0/dy
 rz = 1.0/dz
 
-is = st(1)
-ie = ed(1)
-js = st(2)
-je = ed(2)
-ks = st(3)
-ke = ed(3)
-
-m = dble( (ie-is+1)*(je-js+1)*(ke-ks+1) )
+m = dble(nl)
 flop = flop + m*9.0d0 + 24.0d0
 
 !$OMP PARALLEL &
-!$OMP FIRSTPRIVATE(is, ie, js, je, ks, ke, rx, ry, rz) &
+!$OMP PRIVATE(i, j, k, fcx) &
+!$OMP FIRSTPRIVATE(rx, ry, rz) &
 !$OMP FIRSTPRIVATE(dx, dy, dz, cx, cy, cz, omg_u, omg_v, omg_w, ox, oy, oz) &
 !$OMP PRIVATE(bvx, Ue_t, Uw_t, Vn_t, Vs_t, Wt_t, Wb_t) &
 !$OMP PRIVATE(r_u, r_v, r_w, u_bc, v_bc, w_bc)
 
 !$OMP DO SCHEDULE(static)
 
-do k=ks,ke
-do j=js,je
-do i=is,ie
+do l=1,nl
+i   = lst(1,l)
+j   = lst(2,l)
+k   = lst(3,l)
+fcx = lst(4,l)
 bvx = bv(i,j,k)
 if ( 0 /= iand(bvx, bc_mask30) ) then ! 6面のうちのどれか速度境界フラグが立っている場合
 Ue_t = 0.0
@@ -1392,7 +1358,7 @@ Vs_t = 0.0
 Wt_t = 0.0
 Wb_t = 0.0
 
-if ( ibits(bvx, bc_face_W, bitw_5) == odr ) then
+if ( btest(fcx, X_minus) ) then
 !r_u = ox + (real(i)-1.0)*dx - cx
 r_v = oy + (real(j)-0.5)*dy - cy
 r_w = oz + (real(k)-0.5)*dz - cz
@@ -1402,7 +1368,7 @@ u_bc = omg_v * r_w - omg_w * r_v
 Uw_t = u_bc
 endif
 
-if ( ibits(bvx, bc_face_E, bitw_5) == odr ) then
+if ( btest(fcx, X_plus) ) then
 !r_u = ox +  real(i)     *dx - cx
 r_v = oy + (real(j)-0.5)*dy - cy
 r_w = oz + (real(k)-0.5)*dz - cz
@@ -1412,7 +1378,7 @@ u_bc = omg_v * r_w - omg_w * r_v
 Ue_t = u_bc
 endif
 
-if ( ibits(bvx, bc_face_S, bitw_5) == odr ) then
+if ( btest(fcx, Y_minus) ) then
 r_u = ox + (real(i)-0.5)*dx - cx
 !r_v = oy + (real(j)-1.0)*dy - cy
 r_w = oz + (real(k)-0.5)*dz - cz
@@ -1422,7 +1388,7 @@ v_bc = omg_w * r_u - omg_u * r_w
 Vs_t = v_bc
 endif
 
-if ( ibits(bvx, bc_face_N, bitw_5) == odr ) then
+if ( btest(fcx, Y_plus) ) then
 r_u = ox + (real(i)-0.5)*dx - cx
 !r_v = oy +  real(j)     *dy - cy
 r_w = oz + (real(k)-0.5)*dz - cz
@@ -1432,7 +1398,7 @@ v_bc = omg_w * r_u - omg_u * r_w
 Vn_t = v_bc
 endif
 
-if ( ibits(bvx, bc_face_B, bitw_5) == odr ) then
+if ( btest(fcx, Z_minus) ) then
 r_u = ox + (real(i)-0.5)*dx - cx
 r_v = oy + (real(j)-0.5)*dy - cy
 !r_w = oz + (real(k)-1.0)*dz - cz
@@ -1442,7 +1408,7 @@ w_bc = omg_u * r_v - omg_v * r_u
 Wb_t = w_bc
 endif
 
-if ( ibits(bvx, bc_face_T, bitw_5) == odr ) then
+if ( btest(fcx, Z_plus) ) then
 r_u = ox + (real(i)-0.5)*dx - cx
 r_v = oy + (real(j)-0.5)*dy - cy
 !r_w = oz +  real(k)     *dz - cz
@@ -1458,8 +1424,6 @@ div(i,j,k) = div(i,j,k) + ( rx * (Ue_t - Uw_t) &
                         +   rz * (Wt_t - Wb_t) ) ! 9 flops
 end if
 end do
-end do
-end do
 
 !$OMP END DO
 !$OMP END PARALLEL
@@ -1474,25 +1438,25 @@ end subroutine div_ibc_sldrev
 !! @param [in,out] div  速度の発散
 !! @param [in]     sz   配列長
 !! @param [in]     g    ガイドセル長
-!! @param [in]     st   ループの開始インデクス
-!! @param [in]     ed   ループの終了インデクス
+!! @param [in]     nl   セルリストの要素数
+!! @param [in]     lst  セルリスト (i, j, k, 面フラグ)
 !! @param [in]     v00  参照速度
 !! @param [in]     vel  流出速度
 !! @param [in]     dt   時間積分幅
 !! @param [in]     dh   格子幅
 !! @param [in]     bv   BCindex C
-!! @param [in]     odr  速度境界条件のエントリ
 !! @param [in]     v0   セルセンター速度　u^n
 !! @param [in]     vf   セルフェイス速度ベクトル（n-step）
 !! @param [in,out] flop flop count
 !! @note 流出境界面ではu_e^{n+1}=u_e^n-cf*(u_e^n-u_w^n)を予測値としてdivの寄与として加算
 !! @note flop countはコスト軽減のため近似
 !<
-    subroutine div_ibc_oflow_pvec (div, sz, g, st, ed, v00, vel, dt, dh, bv, odr, v0, vf, flop)
+    subroutine div_ibc_oflow_pvec (div, sz, g, nl, lst, v00, vel, dt, dh, bv, v0, vf, flop)
     implicit none
     include 'ffv_f_params.h'
-    integer                                                   ::  i, j, k, g, bvx, odr, is, ie, js, je, ks, ke
-    integer, dimension(3)                                     ::  sz, st, ed
+    integer                                                   ::  i, j, k, g, bvx, nl, l, fcx
+    integer, dimension(3)                                     ::  sz
+    integer, dimension(4, nl)                                 ::  lst
     double precision                                          ::  flop
     real                                                      ::  m
     real                                                      ::  b_w, b_e, b_s, b_n, b_b, b_t, b_p
@@ -1511,13 +1475,6 @@ end subroutine div_ibc_sldrev
     v_ref = v00(2)
     w_ref = v00(3)
 
-    is = st(1)
-    ie = ed(1)
-    js = st(2)
-    je = ed(2)
-    ks = st(3)
-    ke = ed(3)
-
     cf = vel * dt
 
     rx = 1.0/dh(1)
@@ -1531,7 +1488,8 @@ end subroutine div_ibc_sldrev
     m = 0.0
     
 !$OMP PARALLEL REDUCTION(+:m) &
-!$OMP FIRSTPRIVATE(is, ie, js, je, ks, ke, u_ref, v_ref, w_ref, odr) &
+!$OMP PRIVATE(i, j, k, fcx) &
+!$OMP FIRSTPRIVATE(u_ref, v_ref, w_ref) &
 !$OMP FIRSTPRIVATE(cf1, cf2, cf3, rx, ry, rz) &
 !$OMP PRIVATE(bvx) &
 !$OMP PRIVATE(b_w, b_e, b_s, b_n, b_b, b_t, b_p) &
@@ -1541,9 +1499,11 @@ end subroutine div_ibc_sldrev
 
 !$OMP DO SCHEDULE(static)
 
-    do k=ks,ke
-    do j=js,je
-    do i=is,ie
+    do l=1,nl
+      i   = lst(1,l)
+      j   = lst(2,l)
+      k   = lst(3,l)
+      fcx = lst(4,l)
       bvx = bv(i,j,k)
       if ( 0 /= iand(bvx, bc_mask30) ) then ! 6面のうちのどれか速度境界フラグが立っている場合
 
@@ -1581,39 +1541,39 @@ end subroutine div_ibc_sldrev
         Wb_t = 0.0
         
         ! X方向 ---------------------------------------
-        if ( ibits(bvx, bc_face_W, bitw_5) == odr ) then
+        if ( btest(fcx, X_minus) ) then
           !Uw = Ue + (Vn - Vs + Wt - Wb) ! 連続の式から流出面の速度を推定，これは移動座標系上の速度成分
           if ( cf1>0.0 ) cf1=0.0
           Uw_t = Uw - cf1*(Ue-Uw)
         endif
         
-        if ( ibits(bvx, bc_face_E, bitw_5) == odr ) then
+        if ( btest(fcx, X_plus) ) then
           !Ue = Uw - (Vn - Vs + Wt - Wb)
           if ( cf1<0.0 ) cf1=0.0
           Ue_t = Ue - cf1*(Ue-Uw)
         endif
         
         ! Y方向 ---------------------------------------
-        if ( ibits(bvx, bc_face_S, bitw_5) == odr ) then
+        if ( btest(fcx, Y_minus) ) then
           !Vs = Vn + (Ue - Uw + Wt - Wb)
           if ( cf2>0.0 ) cf2=0.0
           Vs_t = Vs - cf2*(Vn-Vs)
         endif
         
-        if ( ibits(bvx, bc_face_N, bitw_5) == odr ) then
+        if ( btest(fcx, Y_plus) ) then
           !Vn = Vs - (Ue - Uw + Wt - Wb)
           if ( cf2<0.0 ) cf2=0.0
           Vn_t = Vn - cf2*(Vn-Vs)
         endif
         
         ! Z方向 ---------------------------------------
-        if ( ibits(bvx, bc_face_B, bitw_5) == odr ) then
+        if ( btest(fcx, Z_minus) ) then
           !Wb = Wt + (Ue - Uw + Vn - Vs)
           if ( cf3>0.0 ) cf3=0.0
           Wb_t = Wb - cf3*(Wt-Wb)
         endif
         
-        if ( ibits(bvx, bc_face_T, bitw_5) == odr ) then
+        if ( btest(fcx, Z_plus) ) then
           !Wt = Wb - (Ue - Uw + Vn - Vs)
           if ( cf3<0.0 ) cf3=0.0
           Wt_t = Wt - cf3*(Wt-Wb)
@@ -1626,8 +1586,6 @@ end subroutine div_ibc_sldrev
         m = m + 1.0
       end if
     end do
-    end do
-    end do
 !$OMP END DO
 !$OMP END PARALLEL
 
@@ -1642,21 +1600,21 @@ end subroutine div_ibc_sldrev
 !! @param [in]     sz   配列長
 !! @param [in]     g    ガイドセル長
 !! @param [in]     dh   格子幅
-!! @param [in]     st   ループの開始インデクス
-!! @param [in]     ed   ループの終了インデクス
+!! @param [in]     nl   セルリストの要素数
+!! @param [in]     lst  セルリスト (i, j, k, 面フラグ)
 !! @param [in]     bv   BCindex C
-!! @param [in]     odr  速度境界条件のエントリ
 !! @param [out]    av   積算速度と積算数
 !! @param [out]    flop flop count
 !! @note div(u)=0から，内部流出境界のセルで計算されたdivの値が流出速度となる
 !! @note 1つのセルに複数の速度境界条件がある場合にはだめ
 !! @note flop countはコスト軽減のため近似
 !<
-    subroutine div_ibc_oflow_vec (div, sz, g, dh, st, ed, bv, odr, av, flop)
+    subroutine div_ibc_oflow_vec (div, sz, g, dh, nl, lst, bv, av, flop)
     implicit none
     include 'ffv_f_params.h'
-    integer                                                   ::  i, j, k, g, bvx, odr, is, ie, js, je, ks, ke
-    integer, dimension(3)                                     ::  sz, st, ed
+    integer                                                   ::  i, j, k, g, bvx, nl, l, fcx
+    integer, dimension(3)                                     ::  sz
+    integer, dimension(4, nl)                                 ::  lst
     double precision                                          ::  flop
     real                                                      ::  dv, a1, m, dx, dy, dz
     real, dimension(3)                                        ::  dh
@@ -1667,53 +1625,49 @@ end subroutine div_ibc_sldrev
     a1 = 0.0
     m = 0.0
 
-    is = st(1)
-    ie = ed(1)
-    js = st(2)
-    je = ed(2)
-    ks = st(3)
-    ke = ed(3)
-
     dx = dh(1)
     dy = dh(2)
     dz = dh(3)
 
 
 !$OMP PARALLEL &
+!$OMP PRIVATE(i, j, k, fcx) &
 !$OMP REDUCTION(+:a1) &
 !$OMP REDUCTION(+:m) &
-!$OMP FIRSTPRIVATE(is, ie, js, je, ks, ke, odr, dx, dy, dz) &
+!$OMP FIRSTPRIVATE(dx, dy, dz) &
 !$OMP PRIVATE(bvx, dv)
 
 !$OMP DO SCHEDULE(static)
-    do k=ks,ke
-    do j=js,je
-    do i=is,ie
+    do l=1,nl
+      i   = lst(1,l)
+      j   = lst(2,l)
+      k   = lst(3,l)
+      fcx = lst(4,l)
       bvx = bv(i,j,k)
       if ( 0 /= iand(bvx, bc_mask30) ) then ! 6面のうちのどれか速度境界フラグが立っている場合
         dv = div(i,j,k)
         
-        if ( ibits(bvx, bc_face_W, bitw_5) == odr ) then ! u_w
+        if ( btest(fcx, X_minus) ) then ! u_w
           a1 = a1 + dv * dx
         endif
 
-        if ( ibits(bvx, bc_face_E, bitw_5) == odr ) then ! u_e
+        if ( btest(fcx, X_plus) ) then ! u_e
           a1 = a1 - dv * dx
         endif
         
-        if ( ibits(bvx, bc_face_S, bitw_5) == odr ) then
+        if ( btest(fcx, Y_minus) ) then
           a1 = a1 + dv * dy
         endif
         
-        if ( ibits(bvx, bc_face_N, bitw_5) == odr ) then
+        if ( btest(fcx, Y_plus) ) then
           a1 = a1 - dv * dy
         endif
         
-        if ( ibits(bvx, bc_face_B, bitw_5) == odr ) then
+        if ( btest(fcx, Z_minus) ) then
           a1 = a1 + dv * dz
         endif
         
-        if ( ibits(bvx, bc_face_T, bitw_5) == odr ) then
+        if ( btest(fcx, Z_plus) ) then
           a1 = a1 - dv * dz
         endif
 
@@ -1721,8 +1675,6 @@ end subroutine div_ibc_sldrev
         m = m + 1.0
       end if
     end do
-    end do
-    end do
 !$OMP END DO
 !$OMP END PARALLEL
 
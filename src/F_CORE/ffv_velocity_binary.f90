@@ -1525,6 +1525,541 @@ end subroutine update_vec
 
 
 
+!> ********************************************************************
+!! @brief 次ステップのセルセンター，フェイスの速度と発散値を更新し，同じパスで診断量を集計
+!! @param [out] v    n+1時刻のセルセンター速度ベクトル
+!! @param [out] vf   n+1時刻のセルフェイス速度ベクトル
+!! @param [out] div  div {u^{n+1}}
+!! @param [in]  sz   配列長
+!! @param [in]  g    ガイドセル長
+!! @param [in]  dt   時間積分幅
+!! @param [in]  dh   格子幅
+!! @param [in]  vc   セルセンター疑似速度ベクトル
+!! @param [in]  p    圧力 p^{n+1}
+!! @param [in]  bp   BCindex P
+!! @param [in]  bcd  BCindex B
+!! @param [in]  v0   セルセンター速度 u^n
+!! @param [in]  p0   圧力 p^n
+!! @param [in]  v00  参照速度
+!! @param [in]  cm   LCの係数 mach^2/dt（非圧縮の場合 0）
+!! @param [out] dg   ローカルな集計値
+!!                   (1) 発散の最大値 (2) 発散の自乗和 (3) 速度の変化量の和
+!!                   (4) 圧力の変化量の自乗和 (5) 圧力の和 (6) 速度成分の最大値
+!! @param [out] flop 浮動小数点演算数
+!! @note 発散のノルムは，速度境界条件やサブドメインの外周で後から修正される
+!!       セル（いずれかの面のbc_dビットが0，またはi,j,kが1かsz）を除いて集計する．
+!!       除外したセルはnorm_v_div_lst()で修正後に集計する
+!<
+subroutine update_vec_diag (v, vf, div, sz, g, dt, dh, vc, p, bp, bcd, v0, p0, v00, cm, dg, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  i, j, k, ix, jx, kx, g, bpx, bdx
+integer, dimension(3)                                     ::  sz
+double precision                                          ::  flop, d_sq, d_dv, d_dp, d_pa, x, y, z
+real                                                      ::  dt, actv, rx, ry, rz, cm, cs
+real                                                      ::  pc, px, py, pz, pxw, pxe, pys, pyn, pzb, pzt
+real                                                      ::  Ue0, Uw0, Vn0, Vs0, Wt0, Wb0, Up0, Vp0, Wp0
+real                                                      ::  Ue, Uw, Vn, Vs, Wt, Wb
+real                                                      ::  Uef, Uwf, Vnf, Vsf, Wtf, Wbf
+real                                                      ::  c1, c2, c3, c4, c5, c6
+real                                                      ::  N_e, N_w, N_n, N_s, N_t, N_b
+real                                                      ::  c_w, c_e, c_s, c_n, c_b, c_t
+real                                                      ::  d_w, d_e, d_s, d_n, d_b, d_t
+real                                                      ::  u_p, v_p, w_p, dv, dm, r, vx, vy, vz, d_mx, v_mx
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g, 3) ::  v, vc, vf, v0
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  div, p, p0
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bp, bcd
+real, dimension(3)                                        ::  dh
+real, dimension(0:3)                                      ::  v00
+double precision, dimension(6)                            ::  dg
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+rx = 1.0 / dh(1)
+ry = 1.0 / dh(2)
+rz = 1.0 / dh(3)
+
+cs = cm
+vx = v00(1)
+vy = v00(2)
+vz = v00(3)
+
+d_mx = 0.0
+v_mx = 0.0
+d_sq = 0.0
+d_dv = 0.0
+d_dp = 0.0
+d_pa = 0.0
+
+! update_vec 84 + 発散 10 + 速度変化 28 + 圧力変化 7 + 速度最大値 9
+flop = flop + dble(ix)*dble(jx)*dble(kx)*138.0 + 24.0d0
+
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(bpx, actv, bdx) &
+!$OMP PRIVATE(c1, c2, c3, c4, c5, c6) &
+!$OMP PRIVATE(N_e, N_w, N_n, N_s, N_t, N_b) &
+!$OMP PRIVATE(c_w, c_e, c_s, c_n, c_b, c_t) &
+!$OMP PRIVATE(d_w, d_e, d_s, d_n, d_b, d_t) &
+!$OMP PRIVATE(Ue0, Uw0, Vn0, Vs0, Wt0, Wb0, Up0, Vp0, Wp0) &
+!$OMP PRIVATE(Ue, Uw, Vn, Vs, Wt, Wb) &
+!$OMP PRIVATE(Uef, Uwf, Vnf, Vsf, Wtf, Wbf) &
+!$OMP PRIVATE(pc, px, py, pz, pxw, pxe, pys, pyn, pzb, pzt) &
+!$OMP PRIVATE(u_p, v_p, w_p, dv, dm, r, x, y, z) &
+!$OMP REDUCTION(max:d_mx, v_mx) &
+!$OMP REDUCTION(+:d_sq, d_dv, d_dp, d_pa) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, dt, rx, ry, rz, cs, vx, vy, vz)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1,ix
+bpx = bp(i,j,k)
+bdx = bcd(i,j,k)
+actv = real(ibits(bdx, State,  1))
+
+
+! Neumann条件のとき，0.0
+! 物体があればノイマン条件なので，セルフェイスマスクとしても利用
+N_w = real(ibits(bpx, bc_n_W, 1))  ! w
+N_e = real(ibits(bpx, bc_n_E, 1))  ! e
+N_s = real(ibits(bpx, bc_n_S, 1))  ! s
+N_n = real(ibits(bpx, bc_n_N, 1))  ! n
+N_b = real(ibits(bpx, bc_n_B, 1))  ! b
+N_t = real(ibits(bpx, bc_n_T, 1))  ! t
+
+! \phi^D \phi^N
+c_w = real(ibits(bpx, bc_ndag_W, 1))  ! w
+c_e = real(ibits(bpx, bc_ndag_E, 1))  ! e
+c_s = real(ibits(bpx, bc_ndag_S, 1))  ! s
+c_n = real(ibits(bpx, bc_ndag_N, 1))  ! n
+c_b = real(ibits(bpx, bc_ndag_B, 1))  ! b
+c_t = real(ibits(bpx, bc_ndag_T, 1))  ! t
+
+! (1 - \phi^D) \phi^N
+d_w = real(ibits(bpx, bc_dn_W, 1))
+d_e = real(ibits(bpx, bc_dn_E, 1))
+d_s = real(ibits(bpx, bc_dn_S, 1))
+d_n = real(ibits(bpx, bc_dn_N, 1))
+d_b = real(ibits(bpx, bc_dn_B, 1))
+d_t = real(ibits(bpx, bc_dn_T, 1))
+
+
+! 疑似ベクトル
+Uw0 = vc(i-1,j  ,k  , 1)
+Up0 = vc(i  ,j  ,k  , 1)
+Ue0 = vc(i+1,j  ,k  , 1)
+
+Vs0 = vc(i  ,j-1,k  , 2)
+Vp0 = vc(i  ,j  ,k  , 2)
+Vn0 = vc(i  ,j+1,k  , 2)
+
+Wb0 = vc(i  ,j  ,k-1, 3)
+Wp0 = vc(i  ,j  ,k  , 3)
+Wt0 = vc(i  ,j  ,k+1, 3)
+
+Uw = 0.5 * ( Up0 + Uw0 ) * N_w ! 18 flop
+Ue = 0.5 * ( Up0 + Ue0 ) * N_e
+Vs = 0.5 * ( Vp0 + Vs0 ) * N_s
+Vn = 0.5 * ( Vp0 + Vn0 ) * N_n
+Wb = 0.5 * ( Wp0 + Wb0 ) * N_b
+Wt = 0.5 * ( Wp0 + Wt0 ) * N_t
+
+
+! 各面のVBCフラグの有無 => flux mask
+! ibits() = 1(Normal) / 0(VBC)
+c1 = real( ibits(bdx, bc_d_W, 1) )
+c2 = real( ibits(bdx, bc_d_E, 1) )
+c3 = real( ibits(bdx, bc_d_S, 1) )
+c4 = real( ibits(bdx, bc_d_N, 1) )
+c5 = real( ibits(bdx, bc_d_B, 1) )
+c6 = real( ibits(bdx, bc_d_T, 1) )
+
+
+! 圧力勾配 24flop >> DirichletとNeumannの値を0としている
+pc  = p(i, j, k)
+pxw = rx * (-p(i-1,j  ,k  )*c_w + (c_w + 2.0*d_w) * pc )
+pxe = rx * ( p(i+1,j  ,k  )*c_e - (c_e + 2.0*d_e) * pc )
+pys = ry * (-p(i  ,j-1,k  )*c_s + (c_s + 2.0*d_s) * pc )
+pyn = ry * ( p(i  ,j+1,k  )*c_n - (c_n + 2.0*d_n) * pc )
+pzb = rz * (-p(i  ,j  ,k-1)*c_b + (c_b + 2.0*d_b) * pc )
+pzt = rz * ( p(i  ,j  ,k+1)*c_t - (c_t + 2.0*d_t) * pc )
+px = 0.5 * (pxe + pxw)
+py = 0.5 * (pyn + pys)
+pz = 0.5 * (pzt + pzb)
+
+! セルフェイス VBCの寄与と壁面の影響は除外 24flop
+Uwf = (Uw - dt * pxw) * c1 * N_w
+Uef = (Ue - dt * pxe) * c2 * N_e
+Vsf = (Vs - dt * pys) * c3 * N_s
+Vnf = (Vn - dt * pyn) * c4 * N_n
+Wbf = (Wb - dt * pzb) * c5 * N_b
+Wtf = (Wt - dt * pzt) * c6 * N_t
+
+! i=1...ix >> vfは0...ixの範囲をカバーするので，通信不要
+vf(i-1,j  ,k  ,1) = Uwf
+vf(i  ,j  ,k  ,1) = Uef
+vf(i  ,j-1,k  ,2) = Vsf
+vf(i  ,j  ,k  ,2) = Vnf
+vf(i  ,j  ,k-1,3) = Wbf
+vf(i  ,j  ,k  ,3) = Wtf
+
+dv = ((Uef - Uwf) * rx + (Vnf - Vsf) * ry + (Wtf - Wbf) * rz) * actv ! 9flop
+div(i,j,k) = dv
+
+! セルセンタの速度更新 9flop
+u_p = ( Up0 - dt * px ) * actv
+v_p = ( Vp0 - dt * py ) * actv
+w_p = ( Wp0 - dt * pz ) * actv
+v(i,j,k,1) = u_p
+v(i,j,k,2) = v_p
+v(i,j,k,3) = w_p
+
+
+! 発散のノルム　後から修正されるセルを除く
+dm = c1 * c2 * c3 * c4 * c5 * c6
+if ( (i == 1) .or. (i == ix) .or. (j == 1) .or. (j == jx) .or. (k == 1) .or. (k == kx) ) dm = 0.0
+r = ( dv + cs * (pc - p0(i,j,k)) ) * real(ibits(bpx, State, 1)) * dm
+d_mx = max(d_mx, abs(r))
+d_sq = d_sq + dble(r*r)
+
+! 速度の変化量 fb_delta_v()
+x = dble(u_p) - dble(v0(i,j,k,1))
+y = dble(v_p) - dble(v0(i,j,k,2))
+z = dble(w_p) - dble(v0(i,j,k,3))
+d_dv = d_dv + sqrt(x*x + y*y + z*z) * dble(actv)
+
+! 圧力の変化量と和 fb_delta_s()
+x = dble(pc) * dble(actv)
+y = ( dble(pc) - dble(p0(i,j,k)) ) * dble(actv)
+d_pa = d_pa + x
+d_dp = d_dp + y*y
+
+! 速度成分の最大値 find_vmax()
+v_mx = max(v_mx, abs(u_p - vx), abs(v_p - vy), abs(w_p - vz))
+
+end do
+end do
+end do
+!$OMP END DO
+
+!$OMP END PARALLEL
+
+dg(1) = dble(d_mx)
+dg(2) = d_sq
+dg(3) = d_dv
+dg(4) = d_dp
+dg(5) = d_pa
+dg(6) = dble(v_mx)
+
+return
+end subroutine update_vec_diag
+
+
+
+!> ********************************************************************
+!! @brief 局所時間刻みによる速度の増分
+!! @param [out] dv   速度の増分（ガイドセルは0）
+!! @param [in]  sz   配列長
+!! @param [in]  g    ガイドセル長
+!! @param [in]  v    射影後のセルセンター速度
+!! @param [in]  v0   セルセンター速度 u^n
+!! @param [in]  v00  参照速度
+!! @param [in]  dt   時間積分幅（局所時間刻みの上限）
+!! @param [in]  cfl  局所時間刻みのCFL数
+!! @param [in]  dx   最小格子幅
+!! @param [in]  bcd  BCindex B
+!! @param [out] flop 浮動小数点演算数
+!! @note セル毎に dt_l = min(dt, cfl dx/|u|) として，増分を dt_l/dt 倍に縮小する．
+!!       縮小率は1以下なので，定常状態では射影後の速度と一致する
+!<
+subroutine steady_lts_incr (dv, sz, g, v, v0, v00, dt, cfl, dx, bcd, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  i, j, k, l, ix, jx, kx, g
+integer, dimension(3)                                     ::  sz
+double precision                                          ::  flop
+real                                                      ::  dt, cfl, dx, actv, um, sc, cd, vx, vy, vz
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g, 3) ::  dv, v, v0
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bcd
+real, dimension(0:3)                                      ::  v00
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+cd = cfl * dx
+vx = v00(1)
+vy = v00(2)
+vz = v00(3)
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)*17.0d0 + 1.0d0
+
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(actv, um, sc) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, g, dt, cd, vx, vy, vz)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(3)
+do l=1,3
+do k=1-g,kx+g
+do j=1-g,jx+g
+do i=1-g,ix+g
+dv(i,j,k,l) = 0.0
+end do
+end do
+end do
+end do
+!$OMP END DO
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1,ix
+actv = real(ibits(bcd(i,j,k), State, 1))
+
+um = max(abs(v0(i,j,k,1)-vx), abs(v0(i,j,k,2)-vy), abs(v0(i,j,k,3)-vz)) * dt
+
+sc = 1.0
+if ( um > cd ) sc = cd / um
+sc = sc * actv
+
+dv(i,j,k,1) = ( v(i,j,k,1) - v0(i,j,k,1) ) * sc
+dv(i,j,k,2) = ( v(i,j,k,2) - v0(i,j,k,2) ) * sc
+dv(i,j,k,3) = ( v(i,j,k,3) - v0(i,j,k,3) ) * sc
+end do
+end do
+end do
+!$OMP END DO
+
+!$OMP END PARALLEL
+
+return
+end subroutine steady_lts_incr
+
+
+!> ********************************************************************
+!! @brief 速度の増分の陰的残差平滑化 (1 - eps Lap) d = d0 の2色ガウス・ザイデル反復
+!! @param [in,out] dv    平滑化する増分
+!! @param [in]     sz    配列長
+!! @param [in]     g     ガイドセル長
+!! @param [in]     d0    平滑化前の増分
+!! @param [in]     eps   平滑化係数
+!! @param [in]     bcd   BCindex B
+!! @param [in]     ip    開始点インデクス
+!! @param [in]     color グループ番号
+!! @param [out]    flop  浮動小数点演算数
+!! @note 流体セル同士で速度境界条件のない面のみ結合する．d0=0ならば解も0
+!<
+subroutine steady_lts_smooth (dv, sz, g, d0, eps, bcd, ip, color, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  i, j, k, l, ix, jx, kx, g, bdx, ip, color
+integer, dimension(3)                                     ::  sz
+double precision                                          ::  flop
+real                                                      ::  eps, actv, dd
+real                                                      ::  c_w, c_e, c_s, c_n, c_b, c_t
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g, 3) ::  dv, d0
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bcd
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)*54.0d0*0.5d0
+
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(bdx, actv, dd, l) &
+!$OMP PRIVATE(c_w, c_e, c_s, c_n, c_b, c_t) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, eps, ip, color)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1+mod(k+j+color+ip,2), ix, 2
+bdx = bcd(i,j,k)
+actv = real(ibits(bdx, State, 1)) * eps
+
+c_w = real(ibits(bdx, bc_d_W, 1) * ibits(bcd(i-1,j  ,k  ), State, 1)) * actv
+c_e = real(ibits(bdx, bc_d_E, 1) * ibits(bcd(i+1,j  ,k  ), State, 1)) * actv
+c_s = real(ibits(bdx, bc_d_S, 1) * ibits(bcd(i  ,j-1,k  ), State, 1)) * actv
+c_n = real(ibits(bdx, bc_d_N, 1) * ibits(bcd(i  ,j+1,k  ), State, 1)) * actv
+c_b = real(ibits(bdx, bc_d_B, 1) * ibits(bcd(i  ,j  ,k-1), State, 1)) * actv
+c_t = real(ibits(bdx, bc_d_T, 1) * ibits(bcd(i  ,j  ,k+1), State, 1)) * actv
+
+dd = 1.0 / (1.0 + c_w + c_e + c_s + c_n + c_b + c_t)
+
+do l=1,3
+dv(i,j,k,l) = ( d0(i,j,k,l) &
+              + c_w * dv(i-1,j  ,k  ,l) + c_e * dv(i+1,j  ,k  ,l) &
+              + c_s * dv(i  ,j-1,k  ,l) + c_n * dv(i  ,j+1,k  ,l) &
+              + c_b * dv(i  ,j  ,k-1,l) + c_t * dv(i  ,j  ,k+1,l) ) * dd
+end do
+
+end do
+end do
+end do
+!$OMP END DO
+
+!$OMP END PARALLEL
+
+return
+end subroutine steady_lts_smooth
+
+
+!> ********************************************************************
+!! @brief 増分による速度の更新 v = v0 + dv
+!! @param [out] v    セルセンター速度 u^{n+1}
+!! @param [in]  sz   配列長
+!! @param [in]  g    ガイドセル長
+!! @param [in]  v0   セルセンター速度 u^n
+!! @param [in]  dv   速度の増分
+!! @param [in]  bcd  BCindex B
+!! @param [out] flop 浮動小数点演算数
+!<
+subroutine steady_lts_update (v, sz, g, v0, dv, bcd, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  i, j, k, ix, jx, kx, g
+integer, dimension(3)                                     ::  sz
+double precision                                          ::  flop
+real                                                      ::  actv
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g, 3) ::  v, v0, dv
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bcd
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)*6.0d0
+
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(actv) &
+!$OMP FIRSTPRIVATE(ix, jx, kx)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1,ix
+actv = real(ibits(bcd(i,j,k), State, 1))
+v(i,j,k,1) = ( v0(i,j,k,1) + dv(i,j,k,1) ) * actv
+v(i,j,k,2) = ( v0(i,j,k,2) + dv(i,j,k,2) ) * actv
+v(i,j,k,3) = ( v0(i,j,k,3) + dv(i,j,k,3) ) * actv
+end do
+end do
+end do
+!$OMP END DO
+
+!$OMP END PARALLEL
+
+return
+end subroutine steady_lts_update
+
+
+!> ********************************************************************
+!! @brief 局所時間刻みによるセルフェイス速度の増分の縮小
+!! @param [in,out] vf   射影後のセルフェイス速度 >> u^n + 縮小した増分
+!! @param [in]     sz   配列長
+!! @param [in]     g    ガイドセル長
+!! @param [in]     vf0  セルフェイス速度 u^n
+!! @param [in]     v0   セルセンター速度 u^n
+!! @param [in]     v00  参照速度
+!! @param [in]     dt   時間積分幅（局所時間刻みの上限）
+!! @param [in]     cfl  局所時間刻みのCFL数
+!! @param [in]     dx   最小格子幅
+!! @param [out]    flop 浮動小数点演算数
+!! @note 縮小率はsteady_lts_incr()と同じ式で両側のセルから求め，小さい方を用いる
+!<
+subroutine steady_lts_face (vf, sz, g, vf0, v0, v00, dt, cfl, dx, flop)
+implicit none
+integer                                                   ::  i, j, k, ix, jx, kx, g
+integer, dimension(3)                                     ::  sz
+double precision                                          ::  flop
+real                                                      ::  dt, cfl, dx, cd, vx, vy, vz, um, sp, sc
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g, 3) ::  vf, vf0, v0
+real, dimension(0:3)                                      ::  v00
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+cd = cfl * dx
+vx = v00(1)
+vy = v00(2)
+vz = v00(3)
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)*63.0d0 + 1.0d0
+
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(um, sp, sc) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, dt, cd, vx, vy, vz)
+
+! X方向 i=0...ix
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=0,ix
+um = max(abs(v0(i  ,j,k,1)-vx), abs(v0(i  ,j,k,2)-vy), abs(v0(i  ,j,k,3)-vz)) * dt
+sp = 1.0
+if ( um > cd ) sp = cd / um
+um = max(abs(v0(i+1,j,k,1)-vx), abs(v0(i+1,j,k,2)-vy), abs(v0(i+1,j,k,3)-vz)) * dt
+sc = 1.0
+if ( um > cd ) sc = cd / um
+sc = min(sp, sc)
+vf(i,j,k,1) = vf0(i,j,k,1) + ( vf(i,j,k,1) - vf0(i,j,k,1) ) * sc
+end do
+end do
+end do
+!$OMP END DO
+
+! Y方向 j=0...jx
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=0,jx
+do i=1,ix
+um = max(abs(v0(i,j  ,k,1)-vx), abs(v0(i,j  ,k,2)-vy), abs(v0(i,j  ,k,3)-vz)) * dt
+sp = 1.0
+if ( um > cd ) sp = cd / um
+um = max(abs(v0(i,j+1,k,1)-vx), abs(v0(i,j+1,k,2)-vy), abs(v0(i,j+1,k,3)-vz)) * dt
+sc = 1.0
+if ( um > cd ) sc = cd / um
+sc = min(sp, sc)
+vf(i,j,k,2) = vf0(i,j,k,2) + ( vf(i,j,k,2) - vf0(i,j,k,2) ) * sc
+end do
+end do
+end do
+!$OMP END DO
+
+! Z方向 k=0...kx
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=0,kx
+do j=1,jx
+do i=1,ix
+um = max(abs(v0(i,j,k  ,1)-vx), abs(v0(i,j,k  ,2)-vy), abs(v0(i,j,k  ,3)-vz)) * dt
+sp = 1.0
+if ( um > cd ) sp = cd / um
+um = max(abs(v0(i,j,k+1,1)-vx), abs(v0(i,j,k+1,2)-vy), abs(v0(i,j,k+1,3)-vz)) * dt
+sc = 1.0
+if ( um > cd ) sc = cd / um
+sc = min(sp, sc)
+vf(i,j,k,3) = vf0(i,j,k,3) + ( vf(i,j,k,3) - vf0(i,j,k,3) ) * sc
+end do
+end do
+end do
+!$OMP END DO
+
+!$OMP END PARALLEL
+
+return
+end subroutine steady_lts_face
+
+
+
 !> ********************************************************************
 !! @brief 次ステップのセルセンターの速度を更新
 !! @param [out] v        n+1時刻の速度ベクトル
@@ -34,6 +34,11 @@
 #define pssor_          PSSOR
 #define psor2sma_       PSOR2SMA
 #define psor2sma_r_     PSOR2SMA_R
+#define psor_line_      PSOR_LINE
+#define psor2cs_        PSOR2CS
+#define psor2cs_pack_   PSOR2CS_PACK
+#define psor2cs_pack_b_ PSOR2CS_PACK_B
+#define psor2cs_unpack_ PSOR2CS_UNPACK
 #define sma_comm_       SMA_COMM
 #define sma_comm_wait_  SMA_COMM_WAIT
 #define cds_psor_       CDS_PSOR
@@ -51,6 +56,15 @@
 #define blas_calc_rk_        BLAS_CALC_RK
 #define blas_calc_r2_        BLAS_CALC_R2
 #define blas_calc_ax_        BLAS_CALC_AX
+#define blas_heat_b_         BLAS_HEAT_B
+#define blas_heat_ax_        BLAS_HEAT_AX
+#define blas_heat_rk_        BLAS_HEAT_RK
+#define blas_heat_jacobi_    BLAS_HEAT_JACOBI
+#define blas_dot_multi_      BLAS_DOT_MULTI
+#define blas_ml_add_         BLAS_ML_ADD
+#define blas_scal_           BLAS_SCAL
+#define blas_jacobi_scal_    BLAS_JACOBI_SCAL
+#define blas_cheby_          BLAS_CHEBY
 
 
 #endif // _WIN32
@@ -109,6 +123,63 @@ extern "C" {
                     REAL_TYPE* cm,
                     double* flop);
   
+  void psor_line_ (REAL_TYPE* p,
+                   int* sz,
+                   int* g,
+                   REAL_TYPE* dh,
+                   int* dir,
+                   int* ip,
+                   int* color,
+                   REAL_TYPE* omg,
+                   double* cnv,
+                   REAL_TYPE* b,
+                   int* bp,
+                   REAL_TYPE* cm,
+                   double* flop);
+  
+  void psor2cs_ (REAL_TYPE* q,
+                 REAL_TYPE* r,
+                 int* sz,
+                 int* hx,
+                 REAL_TYPE* dh,
+                 int* ip,
+                 int* color,
+                 REAL_TYPE* omg,
+                 double* cnv,
+                 REAL_TYPE* b,
+                 int* bp,
+                 REAL_TYPE* cm,
+                 double* flop);
+  
+  void psor2cs_pack_ (REAL_TYPE* q,
+                      REAL_TYPE* p,
+                      int* sz,
+                      int* g,
+                      int* hx,
+                      int* ip,
+                      int* color,
+                      int* mode);
+  
+  void psor2cs_pack_b_ (REAL_TYPE* qb,
+                        int* qp,
+                        REAL_TYPE* b,
+                        int* bp,
+                        int* sz,
+                        int* g,
+                        int* hx,
+                        int* ip,
+                        int* color,
+                        int* mode);
+  
+  void psor2cs_unpack_ (REAL_TYPE* p,
+                        REAL_TYPE* q,
+                        int* sz,
+                        int* g,
+                        int* hx,
+                        int* ip,
+                        int* color,
+                        int* mode);
+  
   void sma_comm_      (REAL_TYPE* p,
                        int* sz,
                        int* g,
@@ -236,6 +307,88 @@ extern "C" {
                        REAL_TYPE* cm,
                        double* flop);
   
+  void blas_heat_b_   (REAL_TYPE* b,
+                       double* bb,
+                       REAL_TYPE* ws,
+                       REAL_TYPE* qbc,
+                       int* bh,
+                       int* sz,
+                       int* g,
+                       REAL_TYPE* dth1,
+                       double* flop);
+  
+  void blas_heat_ax_  (REAL_TYPE* ap,
+                       REAL_TYPE* p,
+                       int* bh,
+                       int* sz,
+                       int* g,
+                       REAL_TYPE* dth2,
+                       double* flop);
+  
+  void blas_heat_rk_  (REAL_TYPE* r,
+                       REAL_TYPE* x,
+                       REAL_TYPE* b,
+                       int* bh,
+                       int* sz,
+                       int* g,
+                       REAL_TYPE* dth2,
+                       double* flop);
+  
+  void blas_heat_jacobi_ (REAL_TYPE* z,
+                          REAL_TYPE* r,
+                          int* bh,
+                          int* sz,
+                          int* g,
+                          REAL_TYPE* dth2,
+                          double* flop);
+  
+  void blas_dot_multi_ (double* r,
+                        REAL_TYPE* v,
+                        REAL_TYPE* w,
+                        int* nb,
+                        int* bp,
+                        int* sz,
+                        int* g,
+                        double* flop);
+  
+  void blas_ml_add_    (REAL_TYPE* x,
+                        REAL_TYPE* v,
+                        double* c,
+                        int* nb,
+                        int* sz,
+                        int* g,
+                        double* flop);
+  
+  void blas_scal_      (REAL_TYPE* y,
+                        REAL_TYPE* x,
+                        double* a,
+                        int* sz,
+                        int* g,
+                        double* flop);
+  
+  void blas_jacobi_scal_ (REAL_TYPE* z,
+                          REAL_TYPE* r,
+                          double* a,
+                          int* bp,
+                          int* sz,
+                          int* g,
+                          REAL_TYPE* dh,
+                          REAL_TYPE* cm,
+                          double* flop);
+  
+  void blas_cheby_     (REAL_TYPE* x,
+                        REAL_TYPE* d,
+                        REAL_TYPE* r,
+                        REAL_TYPE* q,
+                        double* c1,
+                        double* c2,
+                        int* bp,
+                        int* sz,
+                        int* g,
+                        REAL_TYPE* dh,
+                        REAL_TYPE* cm,
+                        double* flop);
+  
   //***********************************************************************************************
   // ffv_cg.f90
   
@@ -280,6 +280,552 @@ return
 end subroutine psor2sma
 
 
+!> ********************************************************************
+!! @brief ゼブラ順序のライン SOR法
+!! @param [in,out] p     圧力
+!! @param [in]     sz    配列長
+!! @param [in]     g     ガイドセル長
+!! @param [in]     dh    格子幅
+!! @param [in]     dir   ラインの方向 (1:x, 2:y, 3:z)
+!! @param [in]     ip    開始点インデクス（ラインに直交する2方向で決める）
+!! @param [in]     color グループ番号
+!! @param [in]     omg   加速係数
+!! @param [in,out] cnv   収束判定値　修正量の自乗和と残差の自乗和、解ベクトルの自乗和
+!! @param [in]     b     RHS vector
+!! @param [in]     bp    BCindex P
+!! @param [in]     cm    Limited Compressibilityのときの係数
+!! @param [out]    flop  浮動小数演算数
+!! @note ラインに直交する2方向のインデクスの和の偶奇で色分けし，同じ色のラインを同時に
+!!       三重対角行列で解く．ラインの両端の袖の値は既知量とする（ランク境界ではブロックJacobi）．
+!!       配列はガイドセルを含む1次元で参照し，方向によらず同じ処理で扱う．
+!!       スラブ内の同色のラインを詰めたワーク配列上で，ライン方向に逐次，ライン間でSIMD化する．
+!!       残差は更新前の値で積算する（色毎の更新直後の残差は緩和係数1で0になるため）
+!!       ライン直交方向が全てノイマン条件で孤立した区間は特異になり，区間末尾のピボットが0になる．
+!!       このときは末尾のセルを現在値に固定して区間内を解く
+!<
+subroutine psor_line (p, sz, g, dh, dir, ip, color, omg, cnv, b, bp, cm, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  ix, jx, kx, g, idx, dir, ip, color
+integer                                                   ::  ni, nj, nn, nvt, ns, nlm, nl, s, v0, m, n, l
+integer                                                   ::  sn, sv, sl, l0, bm, bq
+integer, dimension(3)                                     ::  sz, st
+double precision                                          ::  flop, res, err, xl2, aa
+real                                                      ::  omg, dd, ss, dp, pp, bb, de, pn, dsw, am, aq, fm, fq, rl
+real                                                      ::  c_w, c_e, c_s, c_n, c_b, c_t
+real                                                      ::  d_w, d_e, d_s, d_n, d_b, d_t
+real                                                      ::  r_xx, r_xy, r_xz, r_x2, r_y2, r_z2
+real                                                      ::  cm, cf, pv
+real, dimension(3)                                        ::  dh
+real, dimension((sz(1)+2*g)*(sz(2)+2*g)*(sz(3)+2*g))      ::  p, b
+integer, dimension((sz(1)+2*g)*(sz(2)+2*g)*(sz(3)+2*g))   ::  bp
+double precision, dimension(3)                            ::  cnv
+real, allocatable, dimension(:,:)                         ::  lo, dg, up, rs
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+ni = ix + 2*g
+nj = jx + 2*g
+
+err = 0.0
+res = 0.0
+xl2 = 0.0
+
+r_xx = 1.0
+r_xy = dh(1) / dh(2)
+r_xz = dh(1) / dh(3)
+r_x2 = r_xx * r_xx
+r_y2 = r_xy * r_xy
+r_z2 = r_xz * r_xz
+
+cf = cm * cm
+
+! 1次元インデクスのストライド
+st(1) = 1
+st(2) = ni
+st(3) = ni * nj
+
+! nn ラインの長さ, nvt スラブ内のライン数, ns スラブ数
+select case (dir)
+case (1)
+  nn  = ix
+  nvt = jx
+  ns  = kx
+  sv  = st(2)
+  sl  = st(3)
+  rl  = r_x2
+case (2)
+  nn  = jx
+  nvt = ix
+  ns  = kx
+  sv  = st(1)
+  sl  = st(3)
+  rl  = r_y2
+case default
+  nn  = kx
+  nvt = ix
+  ns  = jx
+  sv  = st(1)
+  sl  = st(2)
+  rl  = r_z2
+end select
+
+sn  = st(dir)
+bm  = bc_ndag_W + 2*(dir-1)
+bq  = bm + 1
+nlm = (nvt+1)/2
+
+! (1,1,1)の1次元インデクス
+l0 = 1 + g + g*st(2) + g*st(3)
+
+flop = flop + (dble(ix)*dble(jx)*dble(kx) * 71.0d0) * 0.5d0 + 20.0d0
+
+
+!$OMP PARALLEL &
+!$OMP REDUCTION(+:res) &
+!$OMP REDUCTION(+:err) &
+!$OMP REDUCTION(+:xl2) &
+!$OMP PRIVATE(c_w, c_e, c_s, c_n, c_b, c_t) &
+!$OMP PRIVATE(d_w, d_e, d_s, d_n, d_b, d_t) &
+!$OMP PRIVATE(idx, dsw, aa, dd, pp, bb, ss, dp, de, pn, am, aq, fm, fq, pv) &
+!$OMP PRIVATE(s, v0, nl, m, n, l, lo, dg, up, rs) &
+!$OMP FIRSTPRIVATE(nn, nvt, ns, nlm, sn, sv, sl, l0, bm, bq, rl, color, ip, omg) &
+!$OMP FIRSTPRIVATE(r_x2, r_y2, r_z2, cf, st)
+
+allocate( lo(nlm, nn), dg(nlm, nn), up(nlm, nn), rs(nlm, nn) )
+
+!$OMP DO SCHEDULE(static)
+do s=1,ns
+
+  v0 = 1 + mod(s+color+ip, 2)
+  if ( v0 > nvt ) cycle
+  nl = (nvt - v0)/2 + 1
+
+  ! 係数行列と右辺 : dd x_n - am x_{n-1} - aq x_{n+1} = (ss - ライン内の項) - b
+  do n=1,nn
+    fm = 1.0
+    fq = 1.0
+    if ( n == 1  ) fm = 0.0
+    if ( n == nn ) fq = 0.0
+
+    do m=1,nl
+      l = l0 + (n-1)*sn + (v0-1 + 2*(m-1))*sv + (s-1)*sl
+
+      idx = bp(l)
+
+      c_w = real(ibits(idx, bc_ndag_W, 1))
+      c_e = real(ibits(idx, bc_ndag_E, 1))
+      c_s = real(ibits(idx, bc_ndag_S, 1))
+      c_n = real(ibits(idx, bc_ndag_N, 1))
+      c_b = real(ibits(idx, bc_ndag_B, 1))
+      c_t = real(ibits(idx, bc_ndag_T, 1))
+
+      d_w = real(ibits(idx, bc_dn_W, 1))
+      d_e = real(ibits(idx, bc_dn_E, 1))
+      d_s = real(ibits(idx, bc_dn_S, 1))
+      d_n = real(ibits(idx, bc_dn_N, 1))
+      d_b = real(ibits(idx, bc_dn_B, 1))
+      d_t = real(ibits(idx, bc_dn_T, 1))
+
+      dsw = real(ibits(idx, bc_diag, 1))
+
+      dd = r_x2 * (c_w + c_e) &
+         + r_y2 * (c_s + c_n) &
+         + r_z2 * (c_b + c_t) &
+         + 2.0                &
+         *(r_x2 * (d_w + d_e) &
+         + r_y2 * (d_s + d_n) &
+         + r_z2 * (d_b + d_t) ) &
+         + cf
+
+      dd = dsw * dd + 1.0 - dsw
+
+      ss = r_x2 * ( c_e * p(l+st(1)) + c_w * p(l-st(1)) ) &
+         + r_y2 * ( c_n * p(l+st(2)) + c_s * p(l-st(2)) ) &
+         + r_z2 * ( c_t * p(l+st(3)) + c_b * p(l-st(3)) )
+
+      am = rl * real(ibits(idx, bm, 1)) * fm
+      aq = rl * real(ibits(idx, bq, 1)) * fq
+
+      lo(m,n) = -am
+      up(m,n) = -aq
+      dg(m,n) = dd
+      pp = p(l)
+      bb = b(l)
+      rs(m,n) = ss - am * p(l-sn) - aq * p(l+sn) - bb
+
+      ! 更新前の残差
+      de  = bb - (ss - pp * dd)
+      res = res + dble(de*de) * dble(ibits(idx, Active, 1))
+    end do
+  end do
+
+  ! Thomas法 前進消去 upに修正後の上側対角を格納
+  ! ピボットが0（孤立区間の末尾）のセルは現在値に固定し，区間内の後退代入の起点とする
+  do m=1,nl
+    pv = dg(m,1)
+    if ( abs(pv) > 0.0 ) then
+      up(m,1) = up(m,1) / pv
+      rs(m,1) = rs(m,1) / pv
+    else
+      l = l0 + (v0-1 + 2*(m-1))*sv + (s-1)*sl
+      up(m,1) = 0.0
+      rs(m,1) = p(l)
+    endif
+  end do
+
+  do n=2,nn
+    do m=1,nl
+      pv = dg(m,n) - lo(m,n) * up(m,n-1)
+      if ( abs(pv) > 1.0e-6 * abs(dg(m,n)) ) then
+        dd = 1.0 / pv
+        up(m,n) = up(m,n) * dd
+        rs(m,n) = ( rs(m,n) - lo(m,n) * rs(m,n-1) ) * dd
+      else
+        l = l0 + (n-1)*sn + (v0-1 + 2*(m-1))*sv + (s-1)*sl
+        up(m,n) = 0.0
+        rs(m,n) = p(l)
+      endif
+    end do
+  end do
+
+  ! 後退代入
+  do n=nn-1,1,-1
+    do m=1,nl
+      rs(m,n) = rs(m,n) - up(m,n) * rs(m,n+1)
+    end do
+  end do
+
+  ! 緩和して書き戻す
+  do n=1,nn
+    do m=1,nl
+      l = l0 + (n-1)*sn + (v0-1 + 2*(m-1))*sv + (s-1)*sl
+
+      aa = dble(ibits(bp(l), Active, 1))
+      pp = p(l)
+      dp = ( rs(m,n) - pp ) * omg
+      pn = pp + dp
+      p(l) = pn
+
+      xl2 = xl2 + dble(pn*pn) * aa
+      err = err + dble(dp*dp) * aa
+    end do
+  end do
+
+end do
+!$OMP END DO
+
+deallocate( lo, dg, up, rs )
+
+!$OMP END PARALLEL
+
+cnv(1) = cnv(1) + err
+cnv(2) = cnv(2) + res
+cnv(3) = cnv(3) + xl2
+
+return
+end subroutine psor_line
+
+
+!> ********************************************************************
+!! @brief 2-colored SOR法 色分離配置
+!! @param [in,out] q     更新する色の圧力（色分離配置）
+!! @param [in]     r     もう一方の色の圧力（色分離配置）
+!! @param [in]     sz    配列長
+!! @param [in]     hx    色分離配置のi方向の内部セル数 (sz(1)+1)/2
+!! @param [in]     dh    格子幅
+!! @param [in]     ip    開始点インデクス
+!! @param [in]     color グループ番号
+!! @param [in]     omg   加速係数
+!! @param [in,out] cnv   収束判定値　修正量の自乗和と残差の自乗和、解ベクトルの自乗和
+!! @param [in]     b     RHS vector（色分離配置）
+!! @param [in]     bp    BCindex P（色分離配置）
+!! @param [in]     cm    Limited Compressibilityのときの係数
+!! @param [out]    flop  浮動小数演算数
+!! @note 色毎の配列は(j,k)の行毎にその色のセルだけをi方向に詰めたもの．
+!!       行の偶奇 s = mod(k+j+color+ip,2) に対して q(h,j,k) は i = 2h-1+s のセルで，
+!!       隣接セルは r(h-1+s,j,k), r(h+s,j,k), r(h,j±1,k), r(h,j,k±1) となり，全て連続アクセス．
+!!       袖は1層で，q, r の添字は0:hx+1．resは積算
+!<
+subroutine psor2cs (q, r, sz, hx, dh, ip, color, omg, cnv, b, bp, cm, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  h, j, k, ix, jx, kx, hx, he, s, idx
+integer, dimension(3)                                     ::  sz
+double precision                                          ::  flop, res, err, xl2, aa
+real                                                      ::  omg, dd, ss, dp, pp, bb, de, pn, dsw
+real                                                      ::  c_w, c_e, c_s, c_n, c_b, c_t
+real                                                      ::  d_w, d_e, d_s, d_n, d_b, d_t
+real                                                      ::  r_xx, r_xy, r_xz, r_x2, r_y2, r_z2
+real                                                      ::  cm, cf
+real, dimension(3)                                        ::  dh
+real, dimension(0:hx+1, 0:sz(2)+1, 0:sz(3)+1)             ::  q, r
+real, dimension(hx, sz(2), sz(3))                         ::  b
+integer, dimension(hx, sz(2), sz(3))                      ::  bp
+integer                                                   ::  ip, color
+double precision, dimension(3)                            ::  cnv
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+err = 0.0
+res = 0.0
+xl2 = 0.0
+
+r_xx = 1.0
+r_xy = dh(1) / dh(2)
+r_xz = dh(1) / dh(3)
+r_x2 = r_xx * r_xx
+r_y2 = r_xy * r_xy
+r_z2 = r_xz * r_xz
+
+cf = cm * cm
+
+flop = flop + (dble(ix)*dble(jx)*dble(kx) * 57.0d0) * 0.5d0 + 20.0d0
+
+
+!$OMP PARALLEL &
+!$OMP REDUCTION(+:res) &
+!$OMP REDUCTION(+:err) &
+!$OMP REDUCTION(+:xl2) &
+!$OMP PRIVATE(c_w, c_e, c_s, c_n, c_b, c_t) &
+!$OMP PRIVATE(d_w, d_e, d_s, d_n, d_b, d_t) &
+!$OMP PRIVATE(idx, dsw, aa, dd, pp, bb, ss, dp, de, pn, s, he) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, color, ip, omg) &
+!$OMP FIRSTPRIVATE(r_x2, r_y2, r_z2, cf)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+s  = mod(k+j+color+ip, 2)
+he = (ix+1-s)/2
+
+do h=1,he
+  idx = bp(h,j,k)
+
+  c_w = real(ibits(idx, bc_ndag_W, 1))  ! w
+  c_e = real(ibits(idx, bc_ndag_E, 1))  ! e
+  c_s = real(ibits(idx, bc_ndag_S, 1))  ! s
+  c_n = real(ibits(idx, bc_ndag_N, 1))  ! n
+  c_b = real(ibits(idx, bc_ndag_B, 1))  ! b
+  c_t = real(ibits(idx, bc_ndag_T, 1))  ! t
+
+  d_w = real(ibits(idx, bc_dn_W, 1))
+  d_e = real(ibits(idx, bc_dn_E, 1))
+  d_s = real(ibits(idx, bc_dn_S, 1))
+  d_n = real(ibits(idx, bc_dn_N, 1))
+  d_b = real(ibits(idx, bc_dn_B, 1))
+  d_t = real(ibits(idx, bc_dn_T, 1))
+
+  dsw = real(ibits(idx, bc_diag, 1))
+
+  dd = r_x2 * (c_w + c_e) &
+     + r_y2 * (c_s + c_n) &
+     + r_z2 * (c_b + c_t) &
+     + 2.0                &
+     *(r_x2 * (d_w + d_e) &
+     + r_y2 * (d_s + d_n) &
+     + r_z2 * (d_b + d_t) ) &
+     + cf
+
+  dd = dsw * dd + 1.0 - dsw
+
+  aa = dble(ibits(idx, Active, 1))
+
+  pp = q(h,j,k)
+  bb = b(h,j,k)
+
+  ss = r_x2 * ( c_e * r(h+s  ,j  ,k  ) + c_w * r(h-1+s,j  ,k  ) ) &
+     + r_y2 * ( c_n * r(h    ,j+1,k  ) + c_s * r(h    ,j-1,k  ) ) &
+     + r_z2 * ( c_t * r(h    ,j  ,k+1) + c_b * r(h    ,j  ,k-1) )
+
+  dp = ( (ss - bb)/dd - pp ) * omg
+  pn = pp + dp
+  q(h,j,k) = pn
+
+  de  = bb - (ss - pn * dd)
+  res = res + dble(de*de) * aa
+  xl2 = xl2 + dble(pn*pn) * aa
+  err = err + dble(dp*dp) * aa
+end do
+
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+cnv(1) = cnv(1) + err
+cnv(2) = cnv(2) + res
+cnv(3) = cnv(3) + xl2
+
+return
+end subroutine psor2cs
+
+
+!> ********************************************************************
+!! @brief 圧力を色分離配置に詰める
+!! @param [out] q     色分離配置の圧力
+!! @param [in]  p     圧力
+!! @param [in]  sz    配列長
+!! @param [in]  g     ガイドセル長
+!! @param [in]  hx    色分離配置のi方向の内部セル数
+!! @param [in]  ip    開始点インデクス
+!! @param [in]  color グループ番号
+!! @param [in]  mode  0 内部と袖, 1 袖のみ
+!! @note 袖は1層分．行の偶奇によってi=-1またはi=sz(1)+2に対応する位置は参照されないので詰めない
+!<
+subroutine psor2cs_pack (q, p, sz, g, hx, ip, color, mode)
+implicit none
+integer                                                   ::  h, i, j, k, ix, jx, kx, g, hx, s, ip, color, mode
+integer, dimension(3)                                     ::  sz
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  p
+real, dimension(0:hx+1, 0:sz(2)+1, 0:sz(3)+1)             ::  q
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(s, i) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, hx, ip, color, mode)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=0,kx+1
+do j=0,jx+1
+s = mod(k+j+color+ip, 2)
+
+if ( (mode == 0) .or. (j == 0) .or. (j == jx+1) .or. (k == 0) .or. (k == kx+1) ) then
+  do h=0,hx+1
+    i = 2*h-1+s
+    if ( (i >= 0) .and. (i <= ix+1) ) q(h,j,k) = p(i,j,k)
+  end do
+else
+  if ( s == 1 ) q(0,j,k) = p(0,j,k)
+  i = 2*hx-1+s
+  if ( i == ix+1 ) q(hx,j,k) = p(i,j,k)
+  i = 2*hx+1+s
+  if ( i == ix+1 ) q(hx+1,j,k) = p(i,j,k)
+end if
+
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+return
+end subroutine psor2cs_pack
+
+
+!> ********************************************************************
+!! @brief RHSとBCindex Pを色分離配置に詰める
+!! @param [out] qb    色分離配置のRHS
+!! @param [out] qp    色分離配置のBCindex P
+!! @param [in]  b     RHS vector
+!! @param [in]  bp    BCindex P
+!! @param [in]  sz    配列長
+!! @param [in]  g     ガイドセル長
+!! @param [in]  hx    色分離配置のi方向の内部セル数
+!! @param [in]  ip    開始点インデクス
+!! @param [in]  color グループ番号
+!! @param [in]  mode  0 RHSとBCindex P, 1 RHSのみ
+!! @note 内部セルに対応しない位置は0とする
+!<
+subroutine psor2cs_pack_b (qb, qp, b, bp, sz, g, hx, ip, color, mode)
+implicit none
+integer                                                   ::  h, i, j, k, ix, jx, kx, g, hx, s, ip, color, mode
+integer, dimension(3)                                     ::  sz
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  b
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bp
+real, dimension(hx, sz(2), sz(3))                         ::  qb
+integer, dimension(hx, sz(2), sz(3))                      ::  qp
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(s, i) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, hx, ip, color, mode)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+s = mod(k+j+color+ip, 2)
+
+do h=1,hx
+  i = 2*h-1+s
+  if ( i <= ix ) then
+    qb(h,j,k) = b(i,j,k)
+    if ( mode == 0 ) qp(h,j,k) = bp(i,j,k)
+  else
+    qb(h,j,k) = 0.0
+    if ( mode == 0 ) qp(h,j,k) = 0
+  end if
+end do
+
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+return
+end subroutine psor2cs_pack_b
+
+
+!> ********************************************************************
+!! @brief 色分離配置の圧力を元の配置に戻す
+!! @param [in,out] p     圧力
+!! @param [in]     q     色分離配置の圧力
+!! @param [in]     sz    配列長
+!! @param [in]     g     ガイドセル長
+!! @param [in]     hx    色分離配置のi方向の内部セル数
+!! @param [in]     ip    開始点インデクス
+!! @param [in]     color グループ番号
+!! @param [in]     mode  0 全内部セル, 1 領域の面に接する内部セルのみ（袖の同期用）
+!<
+subroutine psor2cs_unpack (p, q, sz, g, hx, ip, color, mode)
+implicit none
+integer                                                   ::  h, i, j, k, ix, jx, kx, g, hx, he, s, ip, color, mode
+integer, dimension(3)                                     ::  sz
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  p
+real, dimension(0:hx+1, 0:sz(2)+1, 0:sz(3)+1)             ::  q
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(s, i, he) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, hx, ip, color, mode)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+s  = mod(k+j+color+ip, 2)
+he = (ix+1-s)/2
+
+if ( (mode == 0) .or. (j == 1) .or. (j == jx) .or. (k == 1) .or. (k == kx) ) then
+  do h=1,he
+    p(2*h-1+s,j,k) = q(h,j,k)
+  end do
+else
+  if ( s == 0 ) p(1,j,k) = q(1,j,k)
+  i = 2*he-1+s
+  if ( i == ix ) p(ix,j,k) = q(he,j,k)
+end if
+
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+return
+end subroutine psor2cs_unpack
+
+
 !> ********************************************************************
 !! @brief 2-colored SOR法 stride memory access, reverse
 !! @param [in,out] p     圧力
@@ -699,3 +699,562 @@ end do
 return
 end subroutine blas_bicg_1
 
+
+
+!> ********************************************************************
+!! @brief 単媒質熱伝導の陰解法の定数項
+!! @param [out] b    定数項
+!! @param [out] bb   定数項の自乗和
+!! @param [in]  ws   対流項のみの部分段階
+!! @param [in]  qbc  境界条件の熱流束
+!! @param [in]  bh   BCindex B
+!! @param [in]  sz   配列長
+!! @param [in]  g    ガイドセル
+!! @param [in]  dth1 dt/dh
+!! @param [out] flop flop count
+!! @note ps_Diff_SM_PSOR()と同じ離散化 (1+dth2*g_p) t_p - dth2 \sum{g a t_nb} = sb + ws
+!<
+subroutine blas_heat_b(b, bb, ws, qbc, bh, sz, g, dth1, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  i, j, k, ix, jx, kx, g, idx
+integer, dimension(3)                                     ::  sz
+real                                                      ::  dth1, sb, a_p
+real                                                      ::  g_w, g_e, g_s, g_n, g_b, g_t
+real                                                      ::  a_w, a_e, a_s, a_n, a_b, a_t
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  b, ws
+real, dimension(6, 1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  qbc
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bh
+double precision                                          ::  flop, bb
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+bb = 0.0
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)*33.0d0
+
+!$OMP PARALLEL &
+!$OMP REDUCTION(+:bb) &
+!$OMP PRIVATE(idx, sb, a_p) &
+!$OMP PRIVATE(g_w, g_e, g_s, g_n, g_b, g_t) &
+!$OMP PRIVATE(a_w, a_e, a_s, a_n, a_b, a_t) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, dth1)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1,ix
+  idx = bh(i,j,k)
+  a_p = real(ibits(idx, Active, 1))
+
+  g_w = real(ibits(idx, gma_W, 1))
+  g_e = real(ibits(idx, gma_E, 1))
+  g_s = real(ibits(idx, gma_S, 1))
+  g_n = real(ibits(idx, gma_N, 1))
+  g_b = real(ibits(idx, gma_B, 1))
+  g_t = real(ibits(idx, gma_T, 1))
+
+  a_w = real(ibits(idx, adbtc_W, 1))
+  a_e = real(ibits(idx, adbtc_E, 1))
+  a_s = real(ibits(idx, adbtc_S, 1))
+  a_n = real(ibits(idx, adbtc_N, 1))
+  a_b = real(ibits(idx, adbtc_B, 1))
+  a_t = real(ibits(idx, adbtc_T, 1))
+
+  sb = -dth1 * ( -(1.0-g_w) * a_w * qbc(1, i, j, k) &
+                 +(1.0-g_e) * a_e * qbc(2, i, j, k) &
+                 -(1.0-g_s) * a_s * qbc(3, i, j, k) &
+                 +(1.0-g_n) * a_n * qbc(4, i, j, k) &
+                 -(1.0-g_b) * a_b * qbc(5, i, j, k) &
+                 +(1.0-g_t) * a_t * qbc(6, i, j, k) )
+
+  b(i,j,k) = (sb + ws(i,j,k)) * a_p
+  bb = bb + dble(b(i,j,k)) * dble(b(i,j,k))
+end do
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+return
+end subroutine blas_heat_b
+
+
+!> ********************************************************************
+!! @brief 単媒質熱伝導の陰解法の係数行列とベクトルの積
+!! @param [out] ap   Ap
+!! @param [in]  p    ベクトル
+!! @param [in]  bh   BCindex B
+!! @param [in]  sz   配列長
+!! @param [in]  g    ガイドセル
+!! @param [in]  dth2 dt/dh^2/Pe
+!! @param [out] flop flop count
+!! @note 非アクティブセルは0
+!<
+subroutine blas_heat_ax(ap, p, bh, sz, g, dth2, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  i, j, k, ix, jx, kx, g, idx
+integer, dimension(3)                                     ::  sz
+real                                                      ::  dth2, dd, ss, a_p
+real                                                      ::  c_w, c_e, c_s, c_n, c_b, c_t
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  ap, p
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bh
+double precision                                          ::  flop
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)*24.0d0
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(idx, dd, ss, a_p) &
+!$OMP PRIVATE(c_w, c_e, c_s, c_n, c_b, c_t) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, dth2)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1,ix
+  idx = bh(i,j,k)
+  a_p = real(ibits(idx, Active, 1))
+
+  c_w = real(ibits(idx, gma_W, 1) * ibits(idx, adbtc_W, 1))
+  c_e = real(ibits(idx, gma_E, 1) * ibits(idx, adbtc_E, 1))
+  c_s = real(ibits(idx, gma_S, 1) * ibits(idx, adbtc_S, 1))
+  c_n = real(ibits(idx, gma_N, 1) * ibits(idx, adbtc_N, 1))
+  c_b = real(ibits(idx, gma_B, 1) * ibits(idx, adbtc_B, 1))
+  c_t = real(ibits(idx, gma_T, 1) * ibits(idx, adbtc_T, 1))
+
+  dd = 1.0 + dth2 * real(ibits(idx, h_diag, 3))
+
+  ss = c_w * p(i-1,j  ,k  ) + c_e * p(i+1,j  ,k  ) &
+     + c_s * p(i  ,j-1,k  ) + c_n * p(i  ,j+1,k  ) &
+     + c_b * p(i  ,j  ,k-1) + c_t * p(i  ,j  ,k+1)
+
+  ap(i,j,k) = (dd * p(i,j,k) - dth2 * ss) * a_p
+end do
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+return
+end subroutine blas_heat_ax
+
+
+!> ********************************************************************
+!! @brief 単媒質熱伝導の陰解法の残差ベクトル r = b - Ax
+!! @param [out] r    残差ベクトル
+!! @param [in]  x    解ベクトル
+!! @param [in]  b    定数項
+!! @param [in]  bh   BCindex B
+!! @param [in]  sz   配列長
+!! @param [in]  g    ガイドセル
+!! @param [in]  dth2 dt/dh^2/Pe
+!! @param [out] flop flop count
+!<
+subroutine blas_heat_rk(r, x, b, bh, sz, g, dth2, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  i, j, k, ix, jx, kx, g, idx
+integer, dimension(3)                                     ::  sz
+real                                                      ::  dth2, dd, ss, a_p
+real                                                      ::  c_w, c_e, c_s, c_n, c_b, c_t
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  r, x, b
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bh
+double precision                                          ::  flop
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)*25.0d0
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(idx, dd, ss, a_p) &
+!$OMP PRIVATE(c_w, c_e, c_s, c_n, c_b, c_t) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, dth2)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1,ix
+  idx = bh(i,j,k)
+  a_p = real(ibits(idx, Active, 1))
+
+  c_w = real(ibits(idx, gma_W, 1) * ibits(idx, adbtc_W, 1))
+  c_e = real(ibits(idx, gma_E, 1) * ibits(idx, adbtc_E, 1))
+  c_s = real(ibits(idx, gma_S, 1) * ibits(idx, adbtc_S, 1))
+  c_n = real(ibits(idx, gma_N, 1) * ibits(idx, adbtc_N, 1))
+  c_b = real(ibits(idx, gma_B, 1) * ibits(idx, adbtc_B, 1))
+  c_t = real(ibits(idx, gma_T, 1) * ibits(idx, adbtc_T, 1))
+
+  dd = 1.0 + dth2 * real(ibits(idx, h_diag, 3))
+
+  ss = c_w * x(i-1,j  ,k  ) + c_e * x(i+1,j  ,k  ) &
+     + c_s * x(i  ,j-1,k  ) + c_n * x(i  ,j+1,k  ) &
+     + c_b * x(i  ,j  ,k-1) + c_t * x(i  ,j  ,k+1)
+
+  r(i,j,k) = (b(i,j,k) - dd * x(i,j,k) + dth2 * ss) * a_p
+end do
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+return
+end subroutine blas_heat_rk
+
+
+!> ********************************************************************
+!! @brief 単媒質熱伝導の陰解法のJacobi前処理 z = D^{-1} r
+!! @param [out] z    前処理後のベクトル
+!! @param [in]  r    ベクトル
+!! @param [in]  bh   BCindex B
+!! @param [in]  sz   配列長
+!! @param [in]  g    ガイドセル
+!! @param [in]  dth2 dt/dh^2/Pe
+!! @param [out] flop flop count
+!<
+subroutine blas_heat_jacobi(z, r, bh, sz, g, dth2, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  i, j, k, ix, jx, kx, g, idx
+integer, dimension(3)                                     ::  sz
+real                                                      ::  dth2
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  z, r
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bh
+double precision                                          ::  flop
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)*14.0d0
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(idx) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, dth2)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1,ix
+  idx = bh(i,j,k)
+  z(i,j,k) = r(i,j,k) * real(ibits(idx, Active, 1)) / (1.0 + dth2 * real(ibits(idx, h_diag, 3)))
+end do
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+return
+end subroutine blas_heat_jacobi
+
+
+!> ********************************************************************
+!! @brief 複数の基底ベクトルとの内積 r(m) = v_m^T w (m=1,nb), r(nb+1) = w^T w
+!! @param [out] r    内積
+!! @param [in]  v    基底ベクトル
+!! @param [in]  w    ベクトル
+!! @param [in]  nb   基底ベクトルの数
+!! @param [in]  bp   BCindex P
+!! @param [in]  sz   配列長
+!! @param [in]  g    ガイドセル
+!! @param [out] flop flop count
+!! @note GMRESの古典Gram-Schmidt直交化で，全基底との内積を1回の走査で求める
+!<
+subroutine blas_dot_multi(r, v, w, nb, bp, sz, g, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                       ::  i, j, k, m, ix, jx, kx, g, nb
+integer, dimension(3)                                         ::  sz
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)        ::  w
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g, nb)    ::  v
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)     ::  bp
+double precision, dimension(nb+1)                             ::  r, rt
+double precision                                              ::  flop, wk
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+r(:) = 0.0d0
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)*(2.0d0*dble(nb) + 3.0d0)
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(wk, m, rt) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, nb)
+
+rt(:) = 0.0d0
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1,ix
+  wk = dble(w(i, j, k)) * dble(ibits(bp(i,j,k), Active, 1))
+  do m=1,nb
+    rt(m) = rt(m) + dble(v(i, j, k, m)) * wk
+  end do
+  rt(nb+1) = rt(nb+1) + dble(w(i, j, k)) * wk
+end do
+end do
+end do
+!$OMP END DO
+
+!$OMP CRITICAL
+r(:) = r(:) + rt(:)
+!$OMP END CRITICAL
+
+!$OMP END PARALLEL
+
+return
+end subroutine blas_dot_multi
+
+
+!> ********************************************************************
+!! @brief 複数の基底ベクトルの線形結合の加算 x = x + \sum_m c(m) v_m
+!! @param [in,out] x    ベクトル
+!! @param [in]     v    基底ベクトル
+!! @param [in]     c    係数
+!! @param [in]     nb   基底ベクトルの数
+!! @param [in]     sz   配列長
+!! @param [in]     g    ガイドセル
+!! @param [out]    flop flop count
+!<
+subroutine blas_ml_add(x, v, c, nb, sz, g, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                       ::  i, j, k, m, ix, jx, kx, g, nb
+integer, dimension(3)                                         ::  sz
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)        ::  x
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g, nb)    ::  v
+double precision, dimension(nb)                               ::  c
+double precision                                              ::  flop, s
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)*(2.0d0*dble(nb) + 1.0d0)
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(s, m) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, nb)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1,ix
+  s = 0.0d0
+  do m=1,nb
+    s = s + c(m) * dble(v(i, j, k, m))
+  end do
+  x(i, j, k) = x(i, j, k) + real(s)
+end do
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+return
+end subroutine blas_ml_add
+
+
+!> ********************************************************************
+!! @brief スカラー倍 y = a x
+!! @param [out] y    ベクトル
+!! @param [in]  x    ベクトル
+!! @param [in]  a    係数
+!! @param [in]  sz   配列長
+!! @param [in]  g    ガイドセル
+!! @param [out] flop flop count
+!<
+subroutine blas_scal(y, x, a, sz, g, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  i, j, k, ix, jx, kx, g
+integer, dimension(3)                                     ::  sz
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  x, y
+double precision                                          ::  flop, a
+real                                                      ::  aa
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+aa = real(a)
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)
+
+!$OMP PARALLEL &
+!$OMP FIRSTPRIVATE(ix, jx, kx, aa)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1,ix
+  y(i, j, k) = aa * x(i, j, k)
+end do
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+return
+end subroutine blas_scal
+
+
+!> ********************************************************************
+!! @brief 対角スケーリング z = a D^{-1} r
+!! @param [out] z    ベクトル
+!! @param [in]  r    ベクトル
+!! @param [in]  a    係数
+!! @param [in]  bp   BCindex P
+!! @param [in]  sz   配列長
+!! @param [in]  g    ガイドセル
+!! @param [in]  dh   格子幅
+!! @param [in]  cm   dh * Mach / dt
+!! @param [out] flop flop count
+!! @note Dはblas_calc_axの係数行列の対角 -dd，対角が0のセルは0
+!<
+subroutine blas_jacobi_scal(z, r, a, bp, sz, g, dh, cm, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  i, j, k, ix, jx, kx, g, idx
+integer, dimension(3)                                     ::  sz
+real                                                      ::  dd, cm, cf, aa
+real                                                      ::  r_xy, r_xz, r_y2, r_z2
+real, dimension(3)                                        ::  dh
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  z, r
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bp
+double precision                                          ::  flop, a
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+aa = real(a)
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)*24.0d0
+
+r_xy = dh(1) / dh(2)
+r_xz = dh(1) / dh(3)
+r_y2 = r_xy * r_xy
+r_z2 = r_xz * r_xz
+
+cf = cm * cm
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(idx, dd) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, aa, r_y2, r_z2, cf)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1,ix
+  idx = bp(i,j,k)
+  dd =         real( ibits(idx, bc_ndag_W, 1) + ibits(idx, bc_ndag_E, 1) &
+             + 2 * ( ibits(idx, bc_dn_W,   1) + ibits(idx, bc_dn_E,   1) ) ) &
+     + r_y2 *  real( ibits(idx, bc_ndag_S, 1) + ibits(idx, bc_ndag_N, 1) &
+             + 2 * ( ibits(idx, bc_dn_S,   1) + ibits(idx, bc_dn_N,   1) ) ) &
+     + r_z2 *  real( ibits(idx, bc_ndag_B, 1) + ibits(idx, bc_ndag_T, 1) &
+             + 2 * ( ibits(idx, bc_dn_B,   1) + ibits(idx, bc_dn_T,   1) ) ) &
+     + cf
+
+  if ( dd > 0.0 ) then
+    z(i, j, k) = -aa * r(i, j, k) * real(ibits(idx, Active, 1)) / dd
+  else
+    z(i, j, k) = 0.0
+  endif
+end do
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+return
+end subroutine blas_jacobi_scal
+
+
+!> ********************************************************************
+!! @brief Chebyshev加速Jacobi反復の1ステップ
+!! @param [in,out] x    解ベクトル
+!! @param [in,out] d    修正量ベクトル
+!! @param [in,out] r    残差ベクトル
+!! @param [in]     q    A d
+!! @param [in]     c1   dの係数
+!! @param [in]     c2   D^{-1} rの係数
+!! @param [in]     bp   BCindex P
+!! @param [in]     sz   配列長
+!! @param [in]     g    ガイドセル
+!! @param [in]     dh   格子幅
+!! @param [in]     cm   dh * Mach / dt
+!! @param [out]    flop flop count
+!! @note r = r - q, d = c1 d + c2 D^{-1} r, x = x + d を1回の走査で行う．内積を含まない
+!<
+subroutine blas_cheby(x, d, r, q, c1, c2, bp, sz, g, dh, cm, flop)
+implicit none
+include 'ffv_f_params.h'
+integer                                                   ::  i, j, k, ix, jx, kx, g, idx
+integer, dimension(3)                                     ::  sz
+real                                                      ::  dd, cm, cf, a1, a2, rr, dn
+real                                                      ::  r_xy, r_xz, r_y2, r_z2
+real, dimension(3)                                        ::  dh
+real, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g)    ::  x, d, r, q
+integer, dimension(1-g:sz(1)+g, 1-g:sz(2)+g, 1-g:sz(3)+g) ::  bp
+double precision                                          ::  flop, c1, c2
+
+ix = sz(1)
+jx = sz(2)
+kx = sz(3)
+a1 = real(c1)
+a2 = real(c2)
+
+flop = flop + dble(ix)*dble(jx)*dble(kx)*29.0d0
+
+r_xy = dh(1) / dh(2)
+r_xz = dh(1) / dh(3)
+r_y2 = r_xy * r_xy
+r_z2 = r_xz * r_xz
+
+cf = cm * cm
+
+!$OMP PARALLEL &
+!$OMP PRIVATE(idx, dd, rr, dn) &
+!$OMP FIRSTPRIVATE(ix, jx, kx, a1, a2, r_y2, r_z2, cf)
+
+!$OMP DO SCHEDULE(static) COLLAPSE(2)
+do k=1,kx
+do j=1,jx
+do i=1,ix
+  idx = bp(i,j,k)
+  dd =         real( ibits(idx, bc_ndag_W, 1) + ibits(idx, bc_ndag_E, 1) &
+             + 2 * ( ibits(idx, bc_dn_W,   1) + ibits(idx, bc_dn_E,   1) ) ) &
+     + r_y2 *  real( ibits(idx, bc_ndag_S, 1) + ibits(idx, bc_ndag_N, 1) &
+             + 2 * ( ibits(idx, bc_dn_S,   1) + ibits(idx, bc_dn_N,   1) ) ) &
+     + r_z2 *  real( ibits(idx, bc_ndag_B, 1) + ibits(idx, bc_ndag_T, 1) &
+             + 2 * ( ibits(idx, bc_dn_B,   1) + ibits(idx, bc_dn_T,   1) ) ) &
+     + cf
+
+  rr = r(i, j, k) - q(i, j, k)
+
+  if ( dd > 0.0 ) then
+    dn = a1 * d(i, j, k) - a2 * rr * real(ibits(idx, Active, 1)) / dd
+  else
+    dn = 0.0
+  endif
+
+  r(i, j, k) = rr
+  d(i, j, k) = dn
+  x(i, j, k) = x(i, j, k) + dn
+end do
+end do
+end do
+!$OMP END DO
+!$OMP END PARALLEL
+
+return
+end subroutine blas_cheby